@@ -0,0 +1,379 @@
+#!/usr/bin/env python3
+"""Local APRS-IS stand-in server and load generator.
+
+Speaks the server side of the logon the firmware expects (banner, "user ...
+pass ..." line, "# logresp ... verified"), sends "#" keepalives and streams
+synthetic m/50-shaped traffic at one or more rates. A fraction of the packets
+are messages to the device's callsign; the acks and replies it sends back are
+matched to them to give reply latency percentiles and drop counts per rate.
+
+Point the device or the simulator at it:
+
+    python aprs_standin.py --rates 20,50,100,200 --to-us 0.02
+    .pio/build/sim/program --aprs 127.0.0.1:14580
+
+The server stops queueing packets to a client that has more than
+--backlog bytes unread, as aprsc drops slow readers, and counts them as
+backlogged. The highest rate with no backlog and no lost replies is the
+rate the device survives.
+
+Failover is tested with one stand-in per server in the firmware's list, each
+on its own port (see --aprs-map in lib/sim/src/sim.h), some of them faulty:
+
+    python aprs_standin.py --port 14001 --refuse --logon-wait 60
+    python aprs_standin.py --port 14002 --no-logresp --logon-wait 60
+    python aprs_standin.py --port 14003 --rates 20
+    .pio/build/sim/program --aprs-map noam.aprs2.net=14001 \
+        --aprs-map rotate.aprs2.net=14002 --aprs-map rotate.aprs.net=14003
+
+--refuse resets every connection, --accept-delay holds the banner back,
+--no-logresp never answers the logon and --logresp-delay answers it late.
+Standard library only.
+"""
+
+import argparse
+import asyncio
+import json
+import math
+import random
+import re
+import socket
+import struct
+import time
+
+BANNER = "# aprsc 2.1.19-standin"
+LATER_PART = re.compile(r"^[2-9]/[2-9] ")  # "2/3 ...", a long reply in parts
+SERVER_NAME = "STANDIN"
+
+# packets not addressed to the device, like an m/50 feed
+BACKGROUND = [
+    "KC2XYZ-9>APDR16,TCPIP*,qAC,T2TEXAS:=3854.61N/07702.04W[/A=000318 on the road",
+    "N3ABC-13>APRS,WIDE1-1,WIDE2-1,qAR,W4KRL-10:!3902.20N/07658.33W#PHG5360 digi",
+    "W4ABC>APN391,TCPIP*,qAC,T2CAN:_10090556c220s004g005t077r000p000P000h50b09900wRSW",
+    "K4QQQ-1>APMI06,TCPIP*,qAS,K4QQQ:T#005,199,000,255,073,123,01101001",
+    "WB4BBB-7>APK102,WIDE1-1,qAR,N4CCC-3:>Monitoring 146.520",
+    "KB3DDD>APWW11,TCPIP*,qAC,T2BC::BLN1     :Net tonight at 2000 on the 2m repeater",
+    "N0EEE-5>APDR16,TCPIP*,qAC,T2USANW::KB3DDD   :ack17",
+    "W3GGG-10>APNU3B,WIDE2-1,qAR,W3HHH-1:!3857.22NS07703.42W#PHG7360/W3,MDn Silver Spring",
+]
+
+
+def aprs_passcode(callsign):
+    """APRS-IS passcode for a callsign, SSID ignored."""
+    call = callsign.split("-")[0].upper()
+    code = 0x73E2
+    for i in range(0, len(call), 2):
+        code ^= ord(call[i]) << 8
+        if i + 1 < len(call):
+            code ^= ord(call[i + 1])
+    return code & 0x7FFF
+
+
+def percentile(values, pct):
+    """Nearest-rank percentile, None if there are no values."""
+    if not values:
+        return None
+    ordered = sorted(values)
+    rank = max(0, math.ceil(pct / 100.0 * len(ordered)) - 1)
+    return ordered[rank]
+
+
+class Stage:
+    """Counters for one offered rate."""
+
+    def __init__(self, rate):
+        self.rate = rate
+        self.start = 0.0
+        self.end = 0.0
+        self.sent = 0
+        self.backlogged = 0
+        self.queries = 0
+        self.retries = 0
+        self.acks = 0
+        self.replies = 0
+        self.duplicate_replies = 0
+        self.later_parts = 0
+        self.ack_ms = []
+        self.reply_ms = []
+        self.pending = {}  # (sender, msg ID) -> [sent at, acked, replied]
+
+    def report(self):
+        elapsed = max(self.end - self.start, 1e-9)
+        lost_acks = sum(1 for p in self.pending.values() if not p[1])
+        lost_replies = sum(1 for p in self.pending.values() if not p[2])
+        return {
+            "offered_pps": self.rate,
+            "sustained_pps": round(self.sent / elapsed, 1),
+            "sent": self.sent,
+            "backlogged": self.backlogged,
+            "queries": self.queries,
+            "retries": self.retries,
+            "acks": self.acks,
+            "replies": self.replies,
+            "lost_acks": lost_acks,
+            "lost_replies": lost_replies,
+            "duplicate_replies": self.duplicate_replies,
+            "later_parts": self.later_parts,
+            "ack_ms": {p: percentile(self.ack_ms, p) for p in (50, 90, 99, 100)},
+            "reply_ms": {p: percentile(self.reply_ms, p) for p in (50, 90, 99, 100)},
+        }
+
+
+class StandIn:
+    """One device session at a time; the load runs while it is logged on."""
+
+    def __init__(self, args):
+        self.args = args
+        self.writer = None
+        self.callsign = None
+        self.verified = asyncio.Event()
+        self.stages = []
+        self.finished = False
+        self.sessions = 0
+        self.disconnects = 0
+        self.device_lines = 0
+        self.filters = []
+        self.query_count = 0
+        self.connections = 0
+        self.logons = 0
+
+    # ******************* device side *********************
+
+    async def handle(self, reader, writer):
+        self.connections += 1
+        if self.args.refuse:
+            sock = writer.get_extra_info("socket")
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack("ii", 1, 0))
+            writer.close()  # linger 0 sends a reset, as a refusing server would
+            return
+        if self.writer is not None:
+            writer.close()  # one device at a time
+            return
+        self.writer = writer
+        if self.args.accept_delay > 0:
+            await asyncio.sleep(self.args.accept_delay)  # a server slow to take the connection
+        self.send(BANNER)
+        try:
+            while True:
+                raw = await reader.readline()
+                if not raw:
+                    break
+                line = raw.decode("ascii", "replace").rstrip("\r\n")
+                if line:
+                    self.on_device_line(line)
+        except ConnectionError:
+            pass
+        finally:
+            if self.verified.is_set() and not self.finished:
+                self.disconnects += 1
+            self.verified.clear()
+            self.writer = None
+            writer.close()
+
+    def on_device_line(self, line):
+        self.device_lines += 1
+        if line.startswith("user "):
+            self.logon(line)
+        elif line.startswith("#filter"):
+            self.filters.append(line[len("#filter"):].strip())
+            self.send("# filter %s active" % self.filters[-1])
+        elif not line.startswith("#"):
+            self.on_device_packet(line)
+
+    def logon(self, line):
+        self.logons += 1
+        if self.args.no_logresp:
+            return
+        if self.args.logresp_delay > 0:
+            asyncio.get_running_loop().call_later(self.args.logresp_delay, self.logresp, line, self.writer)
+        else:
+            self.logresp(line, self.writer)
+
+    def logresp(self, line, writer):
+        """Answers a logon, unless the session that sent it has ended."""
+        if writer is None or writer is not self.writer:
+            return
+        words = line.split()
+        call = words[1] if len(words) > 1 else ""
+        passcode = words[words.index("pass") + 1] if "pass" in words[:-1] else ""
+        ok = passcode == str(aprs_passcode(call))
+        self.send("# logresp %s %s, server %s" % (call, "verified" if ok else "unverified", SERVER_NAME))
+        if ok:
+            self.callsign = call
+            self.sessions += 1
+            self.verified.set()
+
+    def on_device_packet(self, line):
+        """Matches an ack or reply from the device to the query it answers."""
+        header, sep, payload = line.partition(":")
+        if not sep or not payload.startswith(":") or len(payload) < 11 or payload[10] != ":":
+            return
+        addressee = payload[1:10].strip()
+        text = payload[11:]
+        now = time.monotonic()
+        for stage in reversed(self.stages):
+            if LATER_PART.match(text):
+                stage.later_parts += 1  # the reply was matched by its first part
+                return
+            if text.startswith("ack"):
+                entry = stage.pending.get((addressee, text[3:]))
+                if entry is not None and not entry[1]:
+                    entry[1] = True
+                    stage.acks += 1
+                    stage.ack_ms.append((now - entry[0]) * 1000.0)
+                    return
+            else:
+                for key, entry in stage.pending.items():
+                    if key[0] == addressee:
+                        if entry[2]:
+                            stage.duplicate_replies += 1
+                        else:
+                            entry[2] = True
+                            stage.replies += 1
+                            stage.reply_ms.append((now - entry[0]) * 1000.0)
+                        return
+
+    # ******************* server side *********************
+
+    def send(self, line):
+        if self.writer is not None:
+            self.writer.write((line + "\r\n").encode("ascii"))
+
+    def backlog(self):
+        return self.writer.transport.get_write_buffer_size() if self.writer else 0
+
+    def next_packet(self, stage):
+        if random.random() >= self.args.to_us:
+            return random.choice(BACKGROUND)
+        self.query_count += 1
+        sender = "LD%05d" % (self.query_count % 100000)
+        msg_id = str(self.query_count % 100000)
+        stage.pending[(sender, msg_id)] = [time.monotonic(), False, False]
+        stage.queries += 1
+        packet = "%s>APRS,TCPIP*,qAC,%s::%-9s:Load query %d{%s" % (
+            sender, SERVER_NAME, self.callsign, self.query_count, msg_id)
+        if random.random() < self.args.retry_fraction:
+            asyncio.get_running_loop().call_later(self.args.retry_delay, self.resend, stage, packet)
+        return packet
+
+    def resend(self, stage, packet):
+        """A client retrying an unacked message; the device should only re-ack."""
+        if self.verified.is_set():
+            stage.retries += 1
+            self.send(packet)
+
+    async def keepalives(self):
+        while True:
+            await asyncio.sleep(self.args.keepalive)
+            if self.verified.is_set():
+                self.send("%s %s %s" % (BANNER, time.strftime("%d %b %Y %H:%M:%S GMT", time.gmtime()),
+                                        SERVER_NAME))
+
+    async def run_stage(self, rate):
+        stage = Stage(rate)
+        self.stages.append(stage)
+        tick = 0.01
+        owed = 0.0
+        stage.start = time.monotonic()
+        deadline = stage.start + self.args.duration
+        while time.monotonic() < deadline:
+            await self.verified.wait()
+            owed += rate * tick
+            while owed >= 1.0:
+                owed -= 1.0
+                if self.backlog() > self.args.backlog:
+                    stage.backlogged += 1
+                    continue
+                self.send(self.next_packet(stage))
+                stage.sent += 1
+            await asyncio.sleep(tick)
+        stage.end = time.monotonic()
+        await asyncio.sleep(self.args.grace)  # late acks and replies
+        return stage.report()
+
+    async def run(self):
+        server = await asyncio.start_server(self.handle, self.args.host, self.args.port)
+        print("APRS-IS stand-in on %s:%d, waiting for a logon" % (self.args.host, self.args.port))
+        keepalive = asyncio.ensure_future(self.keepalives())
+        try:
+            await asyncio.wait_for(self.verified.wait(), self.args.logon_wait or None)
+            print("logon verified: %s" % self.callsign)
+            rates = self.args.rates
+        except asyncio.TimeoutError:
+            print("no verified logon in %.0f s" % self.args.logon_wait)
+            rates = []
+
+        results = []
+        for rate in rates:
+            result = await self.run_stage(rate)
+            results.append(result)
+            print_stage(result)
+
+        self.finished = True
+        keepalive.cancel()
+        server.close()
+        if self.writer is not None:
+            self.writer.close()  # ends handle()
+            await asyncio.sleep(0.1)
+        summary = {
+            "callsign": self.callsign,
+            "connections": self.connections,
+            "logons": self.logons,
+            "sessions": self.sessions,
+            "disconnects": self.disconnects,
+            "device_lines": self.device_lines,
+            "filters": self.filters,
+            "stages": results,
+        }
+        survived = [r["offered_pps"] for r in results
+                    if r["backlogged"] == 0 and r["lost_replies"] == 0 and r["sustained_pps"] >= 0.95 * r["offered_pps"]]
+        summary["max_survived_pps"] = max(survived) if survived else None
+        print("max rate survived: %s packets/s, disconnects: %d" % (summary["max_survived_pps"], self.disconnects))
+        print("connections: %d, logons: %d, verified sessions: %d" % (self.connections, self.logons, self.sessions))
+        return summary
+
+
+def print_stage(r):
+    def ms(d):
+        return "/".join("-" if d[p] is None else "%.1f" % d[p] for p in (50, 90, 99, 100))
+
+    print("%6s pps offered, %7.1f sustained, %d backlogged | %d queries %d retries: "
+          "%d acks %d replies (%d later parts), lost %d acks %d replies, %d duplicate replies | "
+          "ack ms p50/p90/p99/max %s, reply ms %s"
+          % (r["offered_pps"], r["sustained_pps"], r["backlogged"], r["queries"], r["retries"],
+             r["acks"], r["replies"], r["later_parts"], r["lost_acks"], r["lost_replies"], r["duplicate_replies"],
+             ms(r["ack_ms"]), ms(r["reply_ms"])))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Local APRS-IS stand-in server and load generator")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=14580)
+    parser.add_argument("--rates", default="10,25,50,100", help="packets/s per stage, comma separated")
+    parser.add_argument("--duration", type=float, default=30.0, help="seconds per stage")
+    parser.add_argument("--to-us", type=float, default=0.02, help="fraction of packets that are queries to the device")
+    parser.add_argument("--retry-fraction", type=float, default=0.1, help="fraction of queries sent again")
+    parser.add_argument("--retry-delay", type=float, default=0.5, help="seconds before a query is sent again")
+    parser.add_argument("--keepalive", type=float, default=20.0, help="seconds between # keepalives")
+    parser.add_argument("--grace", type=float, default=2.0, help="seconds to wait for replies after a stage")
+    parser.add_argument("--backlog", type=int, default=64 * 1024, help="unread bytes before packets are held back")
+    parser.add_argument("--refuse", action="store_true", help="reset every connection at once")
+    parser.add_argument("--accept-delay", type=float, default=0.0, help="seconds before the banner is sent")
+    parser.add_argument("--no-logresp", action="store_true", help="never answer the logon")
+    parser.add_argument("--logresp-delay", type=float, default=0.0, help="seconds before the logon is answered")
+    parser.add_argument("--logon-wait", type=float, default=0.0,
+                        help="seconds to wait for a verified logon before giving up, 0 waits forever")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--json", help="write the results here")
+    args = parser.parse_args()
+    args.rates = [float(r) for r in args.rates.split(",") if r]
+    random.seed(args.seed)
+
+    summary = asyncio.run(StandIn(args).run())
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump(summary, out, indent=2)
+
+
+if __name__ == "__main__":
+    main()
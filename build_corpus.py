@@ -0,0 +1,142 @@
+# Compiles data/aphorisms.txt into data/aphorisms.bin, the packed corpus that
+# mountFS() loads from the LittleFS image, and into include/aphorismCorpus.h,
+# the same records as PROGMEM arrays for aphorismFlash.cpp. Runs before every
+# build as a PlatformIO pre: script, or by hand with: python build_corpus.py
+#
+# Layout, little-endian as on the ESP8266:
+#   header   magic "APC1", file size (uint32), record count (uint32)
+#   offsets  count + 1 uint16, the start of each record, then the file size
+#   records  length (uint8) followed by that many ASCII characters
+#
+# Curly quotes and the like are replaced by ASCII; blank and duplicate lines
+# are dropped. Lines longer than one APRS message are listed, since they go
+# out in parts; lines that cannot be sent at all stop the build.
+
+import os
+import struct
+import sys
+
+SOURCE_NAME = "aphorisms.txt"
+CORPUS_NAME = "aphorisms.bin"   # APHORISM_CORPUS in credentials.cpp
+HEADER_NAME = "aphorismCorpus.h"
+MAGIC = b"APC1"
+MESSAGE_MAX = 67                # APRS_MESSAGE_MAX, longer lines are sent in parts
+TEXT_MAX = 160                  # APRS_MULTIPART_TEXT_MAX, longer lines cannot be sent
+FORBIDDEN = "|~{"               # not allowed in APRS message text, pg 71
+
+REPLACEMENTS = {
+    "‘": "'", "’": "'", "‚": "'", "′": "'",
+    "“": '"', "”": '"', "„": '"', "″": '"',
+    "–": "-", "—": "-", "…": "...", " ": " ",
+}
+
+
+def write_if_changed(target, data):
+    old = None
+    if os.path.exists(target):
+        with open(target, "rb") as f:
+            old = f.read()
+    if data != old:
+        with open(target, "wb") as f:
+            f.write(data)
+
+
+def flash_header(records):
+    """Same records as C arrays, the text back to back and where each starts."""
+    lines = [
+        "/**",
+        " * @file %s" % HEADER_NAME,
+        " * @brief Aphorism corpus compiled into flash, generated by build_corpus.py from",
+        " *        data/%s. Do not edit; edit the text file and build." % SOURCE_NAME,
+        " *",
+        " * Record i is APHORISM_FLASH_TEXT[APHORISM_FLASH_OFFSETS[i]] up to the next offset,",
+        " * without a terminator. Included by aphorismFlash.cpp only.",
+        " */",
+        "",
+        "#ifndef APHORISM_CORPUS_H",
+        "#define APHORISM_CORPUS_H",
+        "",
+        "#include <Arduino.h> // PROGMEM",
+        "",
+        "const int APHORISM_FLASH_RECORDS = %d;" % len(records),
+        "",
+        "const uint16_t APHORISM_FLASH_OFFSETS[] PROGMEM = {",
+    ]
+    offset = 0
+    row = []
+    for record in records + [b""]:
+        row.append(str(offset))
+        offset += len(record)
+        if len(row) == 12:
+            lines.append("\t" + ", ".join(row) + ",")
+            row = []
+    if row:
+        lines.append("\t" + ", ".join(row) + ",")
+    lines += ["};", "", "const char APHORISM_FLASH_TEXT[] PROGMEM ="]
+    for record in records:
+        text = record.decode("ascii").replace("\\", "\\\\").replace('"', '\\"')
+        lines.append('\t"%s"' % text)
+    lines[-1] += ";"
+    lines += ["", "#endif // APHORISM_CORPUS_H", "// End of file", ""]
+    return "\n".join(lines).encode("ascii")
+
+
+def compile_corpus(source, target, header):
+    records = []
+    seen = set()
+    errors = []
+    dropped = 0
+    with open(source, encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            for old, new in REPLACEMENTS.items():
+                line = line.replace(old, new)
+            text = " ".join(line.split())
+            if not text or text in seen:
+                dropped += 1
+                continue
+            seen.add(text)
+            bad = sorted(set(c for c in text if ord(c) < 32 or ord(c) > 126 or c in FORBIDDEN))
+            if bad:
+                errors.append("%s:%d: cannot send %s" % (source, number, " ".join(repr(c) for c in bad)))
+            elif len(text) > TEXT_MAX:
+                errors.append("%s:%d: %d characters, at most %d" % (source, number, len(text), TEXT_MAX))
+            elif len(text) > MESSAGE_MAX:
+                print("%s:%d: %d characters, sent in parts" % (source, number, len(text)))
+            records.append(text.encode("ascii", "replace"))
+
+    if errors or not records:
+        for error in errors:
+            print(error)
+        sys.exit("build_corpus: %s not compiled" % source)
+
+    header_size = 12
+    offset = header_size + 2 * (len(records) + 1)
+    offsets = []
+    for record in records:
+        offsets.append(offset)
+        offset += 1 + len(record)
+    offsets.append(offset)
+    if offset > 0xFFFF:
+        sys.exit("build_corpus: corpus is %d bytes, offsets are 16 bits" % offset)
+
+    data = MAGIC + struct.pack("<II", offset, len(records))
+    data += struct.pack("<%dH" % len(offsets), *offsets)
+    for record in records:
+        data += struct.pack("<B", len(record)) + record
+
+    write_if_changed(target, data)
+    write_if_changed(header, flash_header(records))
+    print("build_corpus: %d aphorisms, %d lines dropped, %d bytes in %s" % (len(records), dropped, len(data), target))
+
+
+try:
+    Import("env")  # noqa: F821, run by PlatformIO
+    data_dir = env.subst("$PROJECT_DATA_DIR")  # noqa: F821
+    include_dir = env.subst("$PROJECT_INCLUDE_DIR")  # noqa: F821
+except NameError:
+    project_dir = os.path.dirname(os.path.abspath(sys.argv[0]))
+    data_dir = os.path.join(project_dir, "data")
+    include_dir = os.path.join(project_dir, "include")
+
+compile_corpus(os.path.join(data_dir, SOURCE_NAME), os.path.join(data_dir, CORPUS_NAME),
+               os.path.join(include_dir, HEADER_NAME))
@@ -0,0 +1,53 @@
+/**
+ * @file aphorismCheckpoint.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Keeps the aphorism rotation across reboots.
+ *
+ * @details The rotation (seed, position and corpus size, see
+ * aphorismRotation.h) is written to ESP8266 RTC user memory after every pick;
+ * that memory survives a reset but not a power loss, and has no wear. Every
+ * APHORISM_CHECKPOINT_PICKS picks the rotation is also appended to a small
+ * LittleFS log of fixed-size records, which is started over when it reaches
+ * APHORISM_CHECKPOINT_RECORDS, so flash is written once per that many picks
+ * and never rewritten in place. The new log is written beside the old one and
+ * renamed over it, so a power loss while starting over keeps one of them.
+ *
+ * At boot the RTC copy is used if its check word is right. Otherwise the last
+ * record of the log is read with one seek from the end of the file, or the
+ * one before it if the last was torn by the power loss. The log is up to
+ * APHORISM_CHECKPOINT_PICKS picks behind, so the rotation resumes that many
+ * picks further on: a few aphorisms wait for the next cycle rather than
+ * being repeated. A record for a corpus of another size is not used.
+ */
+
+#ifndef APHORISM_CHECKPOINT_H
+#define APHORISM_CHECKPOINT_H
+
+#include "aphorismRotation.h" // AphorismRotation
+
+#ifndef APHORISM_CHECKPOINT_PICKS
+#define APHORISM_CHECKPOINT_PICKS 16 // picks between records in the log
+#endif
+
+#ifndef APHORISM_CHECKPOINT_RECORDS
+#define APHORISM_CHECKPOINT_RECORDS 64 // records before the log is started over
+#endif
+
+#ifndef APHORISM_RTC_OFFSET
+#define APHORISM_RTC_OFFSET 0 // first 4-byte block of RTC user memory used
+#endif
+
+//! Where the rotation came from at boot
+enum AphorismRestore
+{
+	RESTORE_NONE, // nothing valid, a new rotation
+	RESTORE_RTC,  // RTC user memory, exactly where it was
+	RESTORE_LOG	  // LittleFS log, skipped ahead
+};
+
+bool saveAphorismRotation(const AphorismRotation &rotation);
+AphorismRestore restoreAphorismRotation(AphorismRotation &rotation, uint16_t size);
+
+#endif // APHORISM_CHECKPOINT_H
+// End of file
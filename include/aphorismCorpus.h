@@ -0,0 +1,579 @@
+/**
+ * @file aphorismCorpus.h
+ * @brief Aphorism corpus compiled into flash, generated by build_corpus.py from
+ *        data/aphorisms.txt. Do not edit; edit the text file and build.
+ *
+ * Record i is APHORISM_FLASH_TEXT[APHORISM_FLASH_OFFSETS[i]] up to the next offset,
+ * without a terminator. Included by aphorismFlash.cpp only.
+ */
+
+#ifndef APHORISM_CORPUS_H
+#define APHORISM_CORPUS_H
+
+#include <Arduino.h> // PROGMEM
+
+const int APHORISM_FLASH_RECORDS = 513;
+
+const uint16_t APHORISM_FLASH_OFFSETS[] PROGMEM = {
+	0, 28, 59, 103, 149, 201, 230, 268, 331, 393, 430, 485,
+	521, 558, 596, 638, 667, 706, 744, 800, 835, 874, 913, 940,
+	968, 993, 1025, 1061, 1112, 1156, 1186, 1218, 1264, 1328, 1361, 1389,
+	1456, 1483, 1518, 1560, 1589, 1615, 1648, 1684, 1716, 1774, 1802, 1832,
+	1857, 1889, 1953, 1996, 2024, 2051, 2072, 2109, 2148, 2199, 2237, 2285,
+	2342, 2362, 2404, 2458, 2487, 2519, 2549, 2603, 2654, 2688, 2710, 2769,
+	2794, 2852, 2881, 2930, 2966, 3010, 3047, 3084, 3109, 3139, 3199, 3225,
+	3264, 3294, 3317, 3340, 3391, 3440, 3503, 3555, 3589, 3616, 3641, 3668,
+	3700, 3733, 3766, 3792, 3815, 3845, 3911, 3941, 3960, 4000, 4042, 4081,
+	4106, 4156, 4194, 4229, 4264, 4299, 4330, 4363, 4415, 4459, 4502, 4528,
+	4571, 4596, 4619, 4656, 4688, 4735, 4772, 4810, 4857, 4895, 4931, 4957,
+	4985, 5010, 5040, 5102, 5147, 5179, 5225, 5272, 5332, 5357, 5379, 5406,
+	5425, 5456, 5515, 5561, 5592, 5611, 5652, 5684, 5727, 5749, 5793, 5815,
+	5837, 5868, 5920, 5948, 5984, 6017, 6053, 6085, 6110, 6152, 6212, 6242,
+	6283, 6316, 6355, 6379, 6398, 6443, 6467, 6516, 6548, 6610, 6644, 6683,
+	6727, 6760, 6815, 6838, 6860, 6890, 6922, 6956, 6991, 7015, 7050, 7067,
+	7100, 7132, 7161, 7179, 7254, 7300, 7356, 7381, 7413, 7462, 7499, 7525,
+	7552, 7575, 7602, 7629, 7673, 7714, 7753, 7778, 7802, 7838, 7885, 7931,
+	7994, 8026, 8062, 8088, 8136, 8183, 8218, 8252, 8304, 8349, 8401, 8451,
+	8492, 8516, 8584, 8642, 8661, 8711, 8755, 8802, 8833, 8887, 8933, 8972,
+	9026, 9054, 9090, 9121, 9143, 9174, 9210, 9244, 9301, 9338, 9366, 9399,
+	9428, 9465, 9519, 9579, 9624, 9668, 9698, 9732, 9755, 9803, 9825, 9851,
+	9899, 9926, 9959, 9980, 10016, 10029, 10068, 10087, 10150, 10180, 10209, 10236,
+	10260, 10284, 10307, 10354, 10382, 10404, 10446, 10487, 10572, 10599, 10647, 10678,
+	10693, 10711, 10750, 10771, 10789, 10803, 10834, 10861, 10879, 10909, 10963, 10994,
+	11029, 11056, 11083, 11110, 11131, 11154, 11182, 11211, 11240, 11256, 11302, 11325,
+	11362, 11423, 11455, 11495, 11532, 11583, 11597, 11642, 11671, 11691, 11712, 11729,
+	11768, 11821, 11860, 11890, 11923, 11964, 11988, 12008, 12031, 12062, 12109, 12146,
+	12185, 12227, 12265, 12300, 12330, 12375, 12406, 12424, 12450, 12516, 12564, 12619,
+	12643, 12683, 12717, 12754, 12805, 12828, 12853, 12879, 12916, 12943, 12977, 13004,
+	13036, 13056, 13079, 13125, 13147, 13165, 13178, 13208, 13249, 13271, 13312, 13345,
+	13374, 13466, 13536, 13567, 13594, 13635, 13675, 13733, 13766, 13816, 13847, 13892,
+	13921, 13966, 13994, 14026, 14063, 14115, 14156, 14212, 14259, 14295, 14349, 14391,
+	14412, 14464, 14508, 14549, 14618, 14683, 14714, 14751, 14806, 14848, 14895, 14920,
+	14940, 14974, 14993, 15039, 15112, 15171, 15191, 15259, 15307, 15354, 15385, 15437,
+	15473, 15511, 15565, 15599, 15636, 15683, 15732, 15762, 15794, 15824, 15851, 15882,
+	15920, 15954, 15977, 16013, 16035, 16097, 16127, 16149, 16163, 16186, 16221, 16246,
+	16292, 16338, 16369, 16400, 16421, 16444, 16474, 16504, 16538, 16578, 16607, 16627,
+	16653, 16677, 16716, 16752, 16811, 16842, 16871, 16893, 16942, 16986, 17020, 17044,
+	17084, 17131, 17192, 17257, 17329, 17371, 17406, 17440, 17473, 17507, 17543, 17585,
+	17627, 17662, 17721, 17775, 17821, 17880, 17967, 18002, 18045, 18094, 18140, 18164,
+	18204, 18240, 18287, 18334, 18372, 18399, 18437, 18461, 18489, 18528, 18564, 18606,
+	18631, 18674, 18713, 18746, 18782, 18842, 18887, 18905, 18937, 18967,
+};
+
+const char APHORISM_FLASH_TEXT[] PROGMEM =
+	"A bad penny always turns up."
+	"A bad workman blames his tools."
+	"A bird in the hand is worth two in the bush."
+	"A chain is only as strong as its weakest link."
+	"A clear conscience is the sure sign of a bad memory."
+	"A dog is a man's best friend."
+	"A drowning man will clutch at a straw."
+	"A flawed diamond is better than a common stone that is perfect."
+	"A flea can trouble a lion more than a lion can trouble a flea."
+	"A fool and his money are soon parted."
+	"A foolish consistency is the hobgoblin of little minds."
+	"A friend in need is a friend indeed."
+	"A good beginning makes a good ending."
+	"A good listener is a silent flatterer."
+	"A happy heart is better than a full purse."
+	"A house divided cannot stand."
+	"A jack of all trades is master of none."
+	"A job worth doing is worth doing well."
+	"A journey of a thousand miles begins with a single step."
+	"A leopard doesn't change its spots."
+	"A little learning is a dangerous thing."
+	"A man is known by the company he keeps."
+	"A man's home is his castle."
+	"A miss is as good as a mile."
+	"A new broom sweeps clean."
+	"A penny saved is a penny earned."
+	"A picture is worth a thousand words."
+	"A place for everything and everything in its place."
+	"A prophet is not recognized in his own land."
+	"A rising tide lifts all boats."
+	"A rolling stone gathers no moss."
+	"A rose by any other name would smell as sweet."
+	"A ship in the harbor is safe, but that's not what a ship is for."
+	"A soft answer turneth away wrath."
+	"A stitch in time saves nine."
+	"A sufficiently advanced technology is indistinguishable from magic."
+	"A thing begun is half done."
+	"A thing of beauty is a joy forever."
+	"A tree does not move unless there is wind."
+	"A tree is known by its fruit."
+	"A watched pot never boils."
+	"A word to the wise is sufficient."
+	"Absence makes the heart grow fonder."
+	"Actions speak louder than words."
+	"Adding manpower to a late software project makes it later."
+	"All for one and one for all."
+	"All that glitters is not gold."
+	"All the world is a stage."
+	"All things come to he who waits."
+	"All we learn from history is that we learn nothing from history."
+	"All work and no play makes Jack a dull boy."
+	"All is fair in love and war."
+	"All is well that ends well."
+	"Always cut the cards."
+	"An apple a day keeps the doctor away."
+	"An apple never falls far from the tree."
+	"An hour in the morning is worth two in the evening."
+	"An idle brain is the devil's workshop."
+	"An ounce of prevention is worth a pound of cure."
+	"Any fool can know. The point is to understand. A Einstein"
+	"Any port in a storm."
+	"Anything that can go wrong, will go wrong."
+	"Aphorisms should be short in words and long in wisdom."
+	"Appearances can be deceiving."
+	"April showers bring May flowers."
+	"As you sow, so shall you reap."
+	"As you start to walk on the way, the way appears. Rumi"
+	"Ask a silly question and you'll get a silly answer."
+	"Ask no questions and hear no lies."
+	"Bad news travels fast."
+	"Badges? Badges! I don't got to show you no stinking badges."
+	"Barking dogs seldom bite."
+	"Be careful you don't go from the frying pan into the fire."
+	"Be careful what you wish for."
+	"Be it ever so humble, there's no place like home."
+	"Be not penny wise and pound foolish."
+	"Be slow in choosing, but slower in changing."
+	"Be the flame, not the moth. Cassanova"
+	"Beauty is in the eye of the beholder."
+	"Beauty is only skin deep."
+	"Beat swords into ploughshares."
+	"Before you judge a man, you should walk a mile in his shoes."
+	"Beggars can't be choosers."
+	"Believe in the magic of new beginnings."
+	"Best is the enemy of the good."
+	"Better late than never."
+	"Better safe than sorry."
+	"Better the devil you know than the devil you don't."
+	"Better to be poor and healthy than rich and sick."
+	"Better to have loved and lost, than never to have loved at all."
+	"Better to light a candle than to curse the darkness."
+	"Birds of a feather flock together."
+	"Brevity is the soul of wit."
+	"Business before pleasure."
+	"Carpe diem - seize the day."
+	"Chance favors the prepared mind."
+	"Chickens will come home to roost."
+	"Cleanliness is next to godliness."
+	"Clothes do not make a man."
+	"Cold hands, warm heart."
+	"Common sense is not so common."
+	"Corporations have no bodies to be punished nor souls to be damned."
+	"Cream always rises to the top."
+	"Crime does not pay."
+	"Cross the stream where it is shallowest."
+	"Curses, like chickens, come home to roost."
+	"Discretion is the better part of valor."
+	"Do as I say, not as I do."
+	"Do unto others as you would have them do unto you."
+	"Don't bite off more than you can chew."
+	"Don't bite the hand that feeds you."
+	"Don't burn the candle at both ends."
+	"Don't burn your bridges behind you."
+	"Don't cast pearls before swine."
+	"Don't change horses in midstream."
+	"Don't close the barn door after the horse runs away."
+	"Don't count your chickens before they hatch."
+	"Don't cross the bridge till you come to it."
+	"Don't cry over spilt milk."
+	"Don't cut off your nose to spite your face."
+	"Don't foul your own nest."
+	"Don't give up the ship."
+	"Don't hide your light under a bushel."
+	"Don't judge a book by its cover."
+	"Don't kill the goose that lays the golden eggs."
+	"Don't look a gift horse in the mouth."
+	"Don't make mountains out of molehills."
+	"Don't open a shop unless you know how to smile."
+	"Don't put all your eggs in one basket."
+	"Don't put the cart before the horse."
+	"Don't shoot the messenger."
+	"Don't speak ill of the dead."
+	"Don't spit into the wind."
+	"Don't take any wooden nickels."
+	"Don't think there are no crocodiles because the water is calm."
+	"Don't throw out the baby with the bath water."
+	"Don't throw pearls before swine."
+	"Don't worry about eggs that haven't been laid."
+	"Doubt is the beginning, not the end, of wisdom."
+	"Do you understand the words that are coming out of my mouth?"
+	"Eagles don't catch flies."
+	"Easier said than done."
+	"East or West, home is best."
+	"Easy come, easy go."
+	"Eat to live, don't live to eat."
+	"Eighty percent of consequences come from 20% of the causes."
+	"Embrace solitude; it's the key to inner peace."
+	"Empty bags can't stand upright."
+	"Eschew obfuscation."
+	"Even a broken clock is right twice a day."
+	"Every cloud has a silver lining."
+	"Every day is a new opportunity. Embrace it!"
+	"Every dog has his day."
+	"Every horse thinks its own pack is heaviest."
+	"Every man has a price."
+	"Expect the unexpected."
+	"Experience is the best teacher."
+	"Extraordinary claims require extraordinary evidence."
+	"Familiarity breeds contempt."
+	"Failing to plan is planning to fail."
+	"Fall seven times; stand up eight."
+	"Faults are thick where love is thin."
+	"Finders keepers, losers weepers."
+	"First come, first served."
+	"Fish always stink from the head downwards."
+	"Flattery, like perfume, should be smelled but not swallowed."
+	"Flattery will get you nowhere."
+	"Fools rush in where angels fear to tread."
+	"For everything there is a season."
+	"For want of a nail, a kingdom was lost."
+	"Forewarned is forearmed."
+	"Forgive and forget."
+	"Forgive them, for they know not what they do."
+	"Fortune favors the bold."
+	"From the sublime to the ridiculous is but a step."
+	"Gather ye rosebuds while ye may."
+	"Genius is one percent inspiration and 99 percent perspiration."
+	"Get out while the getting is good."
+	"Give him an inch and he'll take a mile."
+	"Give him enough rope and he'll hang himself."
+	"Give me liberty or give me death."
+	"Give me a lever long enough and I shall move the world."
+	"Give the devil his due."
+	"Go ahead, make my day."
+	"Good bargains empty the purse."
+	"Good fences make good neighbors."
+	"Good gifts come in small packages."
+	"Good things come to those who wait."
+	"Great minds think alike."
+	"Great oaks from little acorns grow."
+	"Grin and bear it."
+	"Growth begins where comfort ends."
+	"Half a loaf is better than none."
+	"Handsome is as handsome does."
+	"Haste makes waste."
+	"He couldn't pour water out of a boot with instructions written on the heel."
+	"He couldn't hit the broad side of a barn door."
+	"He who fights and runs away, lives to fight another day."
+	"He who hesitates is lost."
+	"He who laughs last, laughs best."
+	"He who lives by the sword shall die by the sword."
+	"He who pays the piper calls the tune."
+	"Here today, gone tomorrow."
+	"Home is where the heart is."
+	"History repeats itself."
+	"Hitch your wagon to a star."
+	"Honesty is the best policy."
+	"Hope for the best, but prepare for the worst"
+	"Hope springs eternal in the human breast."
+	"Hunger drives the wolf out of the wood."
+	"Hunger is the best sauce."
+	"I think, therefore I am."
+	"Idle hands are the devil's workshop."
+	"If a job is worth doing it is worth doing well."
+	"If at first you don't succeed, try, try again."
+	"If every man sweeps his doorstep, the city would soon be clean."
+	"If it isn't broken, don't fix it"
+	"If it's not one thing, it's another."
+	"If the shoe fits, wear it."
+	"If wishes were fishes, then no man would starve."
+	"If wishes were horses, then beggars would ride."
+	"If you buy cheaply, you pay dearly."
+	"If you can't beat them, join them."
+	"If you can't stand the heat, get out of the kitchen."
+	"If you find yourself in a hole, stop digging."
+	"If you have nothing to do, please do not do it here."
+	"If you lie down with dogs, you wake up with fleas."
+	"If you play with fire, you'll get burned."
+	"If you snooze, you lose."
+	"If you tell the truth, you don't have to remember anything. M. Twain"
+	"If you want something done right, you must do it yourself."
+	"Ignorance is bliss."
+	"Ignorance of the law is no excuse for breaking it."
+	"Imitation is the sincerest form of flattery."
+	"I'm going to make him an offer he can't refuse."
+	"In for a penny, in for a pound."
+	"In the country of the blind, the one-eyed man is king."
+	"In the quiet moments, we find our true selves."
+	"It always takes longer than you expect."
+	"It is not what you are called, but what you answer to."
+	"It never rains but it pours."
+	"It takes a village to raise a child."
+	"It takes two to make a quarrel."
+	"It takes two to tango."
+	"It'll all come out in the wash."
+	"It's an ill wind that blows no good."
+	"It's better to be safe than sorry."
+	"It's better to light a candle than to curse the darkness."
+	"It's easy to be wise after the event."
+	"It's never too late to mend."
+	"It's no use beating a dead horse."
+	"It's not over till it's over."
+	"It's not the heat, it's the humidity."
+	"It's not the knowing that is difficult, but the doing."
+	"It's not whether you win or lose, but how you play the game."
+	"It's the empty can that makes the most noise."
+	"It's the squeaky wheel that gets the grease."
+	"It's time to fish or cut bait."
+	"Justice delayed is justice denied."
+	"Keep a stiff upper lip."
+	"Keep smiling, and the world will smile with you!"
+	"Keep your eyes peeled."
+	"Keep your fingers crossed."
+	"Keep your friends close and your enemies closer."
+	"Keep your head above water."
+	"Keep your nose to the grindstone."
+	"Keep your powder dry."
+	"Kind words will unlock an iron door."
+	"Know thyself."
+	"Know which side your bread is buttered."
+	"Knowledge is power."
+	"Laugh, and the world laughs with you; weep, and you weep alone."
+	"Laughter is the best medicine."
+	"Learn to walk before you run."
+	"Least said, soonest mended."
+	"Leave no stone unturned."
+	"Leave well enough alone."
+	"Let bygones be bygones."
+	"Let he who is without sin cast the first stone."
+	"Let nature takes its course."
+	"Let sleeping dogs lie."
+	"Let's cross the bridge when we come to it."
+	"Life's deepest insights come from within."
+	"Life is like riding a bicycle. To keep your balance, you must keep moving. A Einstein"
+	"Life is short, art is long."
+	"Lightning never strikes twice in the same place."
+	"Little strokes fell great oaks."
+	"Live and learn."
+	"Live and let live."
+	"Live every day as if it were your last."
+	"Look before you leap."
+	"Love conquers all."
+	"Love is blind."
+	"Love makes the world go 'round."
+	"Make a virtue of necessity."
+	"Make haste slowly."
+	"Make hay while the sun shines."
+	"Make yourself all honey and the flies will devour you."
+	"Man cannot live by bread alone."
+	"Many are called but few are chosen."
+	"Many hands make light work."
+	"May the force be with you.\""
+	"Measure twice and cut once."
+	"Misery loves company."
+	"Money isn't everything."
+	"Money doesn't grow on trees."
+	"More die of food than famine."
+	"Morgenstund hat Gold im Mund."
+	"Murder will out."
+	"Music hath charms to soothe the savage breast."
+	"Nature abhors a vacuum."
+	"Necessity is the mother of invention."
+	"Never attribute to malice what can be explained by stupidity."
+	"Never judge a book by its cover."
+	"Never let the sun go down on your anger."
+	"Never look a gift horse in the mouth."
+	"Never put off until tomorrow what you can do today."
+	"Never say die."
+	"Never test the depth of water with both feet."
+	"No man can serve two masters."
+	"No man is an island."
+	"No news is good news."
+	"No pain, no gain."
+	"Nobody expects the Spanish Inquisition!"
+	"Nothing ever gets built on schedule or within budget."
+	"Nothing is certain but death and taxes."
+	"Nothing succeeds like success."
+	"Nothing ventured, nothing gained."
+	"Oaks may fall when reeds stand the storm."
+	"Oil and water don't mix."
+	"Old habits die hard."
+	"Once bitten, twice shy."
+	"One good turn deserves another."
+	"One hand for oneself and one hand for the ship."
+	"One man's loss is another man's gain."
+	"One man's meat is another man's poison."
+	"One man's trash is another man's treasure."
+	"One picture is worth a thousand words."
+	"One rotten apple spoils the barrel."
+	"Only a cat may look at a king."
+	"Only the wearer knows where the shoe pinches."
+	"Opportunity never knocks twice."
+	"Opposites attract."
+	"Out of sight, out of mind."
+	"Patience in a moment of anger will avoid a hundred days of sorrow."
+	"Pay no attention to that man behind the curtain."
+	"People who live in glass houses shouldn't throw stones."
+	"Physician, heal thyself."
+	"Politeness costs little but yields much."
+	"Politics makes strange bedfellows."
+	"Possession is nine-tenths of the law."
+	"Power corrupts; absolute power corrupts absolutely."
+	"Practice makes perfect."
+	"Practice what you preach."
+	"Pride goeth before a fall."
+	"Procrastination is the thief of time."
+	"Rats desert a sinking ship."
+	"Revenge is a dish best eaten cold."
+	"Rome wasn't built in a day."
+	"Round up all the usual suspects."
+	"Seeing is believing."
+	"Seek and ye shall find."
+	"Self-reflection is the path to self-discovery."
+	"Share and share alike."
+	"Silence is golden."
+	"Sink or swim."
+	"Slow and steady wins the race."
+	"Smooth seas do not make skillful sailors."
+	"Still waters run deep."
+	"Spread love and kindness wherever you go."
+	"Stone walls do not a prison make."
+	"Strike while the iron is hot."
+	"Study without desire spoils the memory, and it retains nothing that it takes in. L. da Vinci"
+	"Tact is the knack of making a point without making an enemy. I. Newton"
+	"Take the bitter with the sweet."
+	"Take the bull by the horns."
+	"The apple doesn't fall far from the tree."
+	"The bad workman always blames his tools."
+	"The best revenge is not to be like your enemy. M. Aurelius"
+	"The best things in life are free."
+	"The best-laid plans of mice and men often go awry."
+	"The burnt child shuns the fire."
+	"The course of true love never did run smooth."
+	"The customer is always right."
+	"The family that eats together stays together."
+	"The devil is in the details."
+	"The early bird catches the worm."
+	"The eyes are the windows to the soul."
+	"The grass is greener on the other side of the fence."
+	"The harder you work, the luckier you get."
+	"The higher the monkey climbs the more he shows his tail."
+	"The hotter the battle, the sweeter the victory."
+	"The leopard cannot change its spots."
+	"The longest journey begins with but a single footstep."
+	"The love of money is the root of all evil."
+	"The more the merrier."
+	"The more things change, the more they stay the same."
+	"The nail that sticks out gets hammered down."
+	"The only free cheese is in the mousetrap."
+	"The only real mistake is the one from which we learn nothing. H. Ford"
+	"The number of transistors in an IC doubles about every two years."
+	"The pen is mightier than sword."
+	"The quality of mercy is not strained."
+	"The perversity of the Universe tends towards a maximum."
+	"The proof of the pudding is in the eating."
+	"The road to hell is paved with good intentions."
+	"The sea refuses no river."
+	"The show must go on."
+	"The squeaky wheel gets the grease."
+	"The truth will out."
+	"The teacher appears when the student is ready."
+	"The truth is not always beautiful, nor beautiful words the truth. Lao Tzu"
+	"The turtle only makes progress when it sticks its neck out."
+	"The walls have ears."
+	"The way to get started is to quit talking and begin doing. W. Disney"
+	"The way to a man's heart is through his stomach."
+	"The whole is greater than the sum of the parts."
+	"The wish is father of the deed."
+	"There ain't no such thing as a free lunch. TANSTAAFL"
+	"There are plenty of fish in the sea."
+	"There are two sides to every question."
+	"There is nothing good or bad but thinking makes it so."
+	"There is no time like the present."
+	"There is a first time for everything."
+	"There's many a slip 'twixt the cup and the lip."
+	"There's many a good tune played on an old fiddle."
+	"There's method in his madness."
+	"There's no accounting for taste."
+	"There's no crying in baseball!"
+	"There's no place like home."
+	"There's no rest for the wicked."
+	"There's no such thing as a free lunch."
+	"There's nothing new under the sun."
+	"There is truth in wine."
+	"Things aren't always what they seem."
+	"Think first, then act."
+	"Those who cannot remember the past are condemned to repeat it."
+	"Time and tide wait for no man."
+	"Time heals all wounds."
+	"Time is money."
+	"Time is of the essence."
+	"To err is human, to forgive divine."
+	"To infinity...and beyond."
+	"To know the road ahead, ask those coming back."
+	"Tomorrow is often the busiest day of the week."
+	"Too many cooks spoil the broth."
+	"Truth is stranger than fiction."
+	"Turn the other cheek."
+	"Turnabout is fair play."
+	"Two heads are better than one."
+	"Two wrongs don't make a right."
+	"Two are company, three is a crowd."
+	"Uneasy lies the head that wears a crown."
+	"Variety is the spice of life."
+	"Waste not, want not."
+	"Water seeks its own level."
+	"Well begun is half done."
+	"We are too soon old and too late smart."
+	"What can't be cured must be endured."
+	"What cannot be settled by experiment is not worth debating."
+	"What goes around, comes around."
+	"What goes up, must come down."
+	"What will be, will be."
+	"What's good for the goose is good for the gander."
+	"When all you have are lemons, make lemonade."
+	"When in Rome, do as the Romans do."
+	"When it rains, it pours."
+	"When the cat's away, the mice will play."
+	"When the going gets tough, the tough get going."
+	"When you fish for love, bait with your heart, not your brain."
+	"When your only tool is a hammer, every problem looks like a nail."
+	"Whether you think you can, or you think you can't--you're right. H. Ford"
+	"While the cat is away, the mice will play."
+	"Where there's will, there is a way."
+	"Where there's smoke, there's fire."
+	"While there's life, there's hope."
+	"Who pays the piper calls the tune."
+	"Why buy a cow when milk is so cheap?"
+	"Why don't you come up sometime and see me?"
+	"Winners never quit and quitters never win."
+	"Words must be weighed, not counted."
+	"Wrinkles should merely indicate where the smiles have been."
+	"You can catch more flies with honey than with vinegar."
+	"You can kill a man but you can't kill an idea."
+	"You can lead a horse to water, but you can't make it drink."
+	"You can take the boy out of the country, but you can't take the country out of the boy."
+	"You can't always get what you want."
+	"You can't fit a round peg in a square hole."
+	"You can't fool all of the people all of the time."
+	"You can't get the toothpaste back in the tube."
+	"You can't go home again."
+	"You can't have your cake and eat it too."
+	"You can't judge a book by its cover."
+	"You can't make a silk purse out of a sow's ear."
+	"You can't make an omelet without breaking eggs."
+	"You can't squeeze blood from a turnip."
+	"You can't take it with you."
+	"You can't teach an old dog new tricks."
+	"You can't unring a bell."
+	"You can't unscramble an egg."
+	"You do not fatten a pig by weighing it."
+	"You don't get something for nothing."
+	"You don't see the forest for all the trees"
+	"You get what you pay for."
+	"You have to take the bitter with the sweet."
+	"You have to take the good with the bad."
+	"You made your bed, now lie in it."
+	"You need to stop to smell the roses."
+	"You need to take a bull by the horns, and a man by his word."
+	"You pays your money and you take your choice."
+	"You talkin' to me?"
+	"You're gonna need a bigger boat."
+	"You're never too old to learn.";
+
+#endif // APHORISM_CORPUS_H
+// End of file
@@ -0,0 +1,28 @@
+/**
+ * @file aphorismFlash.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Aphorisms compiled into the firmware as PROGMEM arrays.
+ *
+ * @details build_corpus.py writes the cleaned records of data/aphorisms.txt
+ * into include/aphorismCorpus.h as one text array and a table of where each
+ * record starts. A record is copied out of memory-mapped flash with
+ * memcpy_P(), so no file system, file handle or index is involved and a read
+ * touches only that record.
+ *
+ * Build with -DAPHORISM_PROGMEM to have mountFS() and pickAphorism() use
+ * these records instead of LittleFS. Without it nothing here is referenced
+ * and the linker leaves the arrays out.
+ */
+
+#ifndef APHORISM_FLASH_H
+#define APHORISM_FLASH_H
+
+#include <Arduino.h> // for String class
+
+int flashAphorismCount();
+size_t readFlashAphorism(int line, char *text, size_t size);
+String flashAphorism(int line);
+
+#endif // APHORISM_FLASH_H
+// End of file
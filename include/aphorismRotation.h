@@ -0,0 +1,36 @@
+/**
+ * @file aphorismRotation.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Order in which the aphorisms are picked, in a few bytes of state.
+ *
+ * @details Instead of a shuffled array of every line number, the order of a
+ * cycle is a pseudorandom permutation computed from a seed: a 4-round Feistel
+ * network over the smallest power-of-four range that holds the corpus, with
+ * cycle-walking to skip values past its end. Position i of the cycle maps to
+ * a distinct line for every i, so a cycle picks each aphorism once, and the
+ * whole rotation is the seed, the position and the corpus size.
+ *
+ * At the end of a cycle the next seed starts a new order; a seed whose first
+ * line would repeat the last one is passed over.
+ */
+
+#ifndef APHORISM_ROTATION_H
+#define APHORISM_ROTATION_H
+
+#include <stdint.h> // uint32_t
+
+//! Where the rotation is: the permutation of this cycle and how far into it
+struct AphorismRotation
+{
+	uint32_t seed = 0;	   // selects the permutation of this cycle
+	uint16_t position = 0; // picks made in this cycle
+	uint16_t size = 0;	   // aphorisms in the corpus, 0 if none
+};
+
+uint16_t permuteAphorismIndex(uint32_t seed, uint16_t index, uint16_t size);
+void startAphorismRotation(AphorismRotation &rotation, uint16_t size, uint32_t seed);
+int nextAphorismIndex(AphorismRotation &rotation, uint32_t freshSeed);
+
+#endif // APHORISM_ROTATION_H
+// End of file
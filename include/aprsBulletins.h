@@ -0,0 +1,59 @@
+/**
+ * @file aprsBulletins.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Sends scheduled APRS bulletins from a table of local times.
+ *
+ * @details Each entry of APRS_BULLETIN_SCHEDULE gives a local time, the
+ * bulletin ID and where the text comes from. The next occurrence of every
+ * entry is worked out once and a single ezTime event is set for the earliest,
+ * so nothing is checked per minute. When the event runs, every entry that has
+ * come due is marked and moved to its next occurrence, so each occurrence is
+ * sent once even if loop() stalled through its minute. A due bulletin waits
+ * for the APRS-IS logon, up to APRS_BULLETIN_CATCHUP seconds late; older ones
+ * are counted as missed.
+ *
+ * The aphorism for the next bulletin is picked while nothing is due, so
+ * sending it only formats and queues the packet. Long aphorisms go out in
+ * numbered parts, see aprsMultipart.h.
+ */
+
+#ifndef APRS_BULLETINS_H
+#define APRS_BULLETINS_H
+
+#include <stdint.h> // uint8_t
+
+#ifndef APRS_BULLETIN_CATCHUP
+#define APRS_BULLETIN_CATCHUP 1800 // seconds a bulletin may be sent late
+#endif
+
+//! Where the text of a bulletin comes from
+enum APRSBulletinSource
+{
+	BULLETIN_APHORISM // next aphorism from pickAphorism()
+};
+
+//! One scheduled bulletin, every day at hour:minute local time
+struct APRSBulletinEntry
+{
+	uint8_t hour;
+	uint8_t minute;
+	char id; // bulletin ID 0-9 or announcement ID A-Z, pg 83
+	APRSBulletinSource source;
+};
+
+//! Bulletin counters
+struct APRSBulletinStats
+{
+	unsigned long sent = 0;	  // bulletins queued for APRS-IS
+	unsigned long late = 0;	  // sent a minute or more after their time
+	unsigned long missed = 0; // not sent within APRS_BULLETIN_CATCHUP
+	unsigned long failed = 0; // no text or the packet could not be built
+};
+
+extern APRSBulletinStats bulletinStats;
+
+void processBulletins();
+
+#endif // APRS_BULLETINS_H
+// End of file
@@ -0,0 +1,42 @@
+/**
+ * @file aprsCapture.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Records the APRS-IS receive stream to LittleFS and plays it back.
+ *
+ * @details In capture mode every line readAPRSPacket() receives is appended to
+ * a LittleFS file with its millis() stamp, in the format APRSReplaySource
+ * reads (see aprsReplay.h). In replay mode readAPRSPacket() takes its lines
+ * from such a file instead of the server, so parsing, duplicate detection
+ * and the responder see recorded traffic with no live connection.
+ *
+ * A capture replaces any earlier file at its path, so copy it off the device
+ * before the next boot starts another.
+ *
+ * Either mode can be started at boot with a build flag:
+ *
+ *     -D APRS_CAPTURE_FILE=\"/capture.log\"
+ *     -D APRS_REPLAY_FILE=\"/capture.log\"   (add -D APRS_REPLAY_FAST for no pacing)
+ */
+
+#ifndef APRS_CAPTURE_H
+#define APRS_CAPTURE_H
+
+#include "aprsLineReader.h" // for APRSLine, APRSLineReader
+
+const unsigned long APRS_CAPTURE_MAX_BYTES = 256UL * 1024UL; // capture stops at this file size
+const int APRS_CAPTURE_FLUSH_LINES = 32;					 // lines between flushes to flash
+
+bool startAPRSCapture(const char *path);
+void stopAPRSCapture();
+void captureAPRSLine(const APRSLine &line);
+
+bool startAPRSReplay(const char *path, bool realTime);
+void stopAPRSReplay();
+bool aprsReplayActive();
+bool readAPRSReplay(APRSLineReader &reader, APRSLine &line);
+
+void beginAPRSCapture();
+
+#endif // APRS_CAPTURE_H
+// End of file
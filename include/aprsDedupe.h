@@ -0,0 +1,57 @@
+/**
+ * @file aprsDedupe.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Duplicate suppression for retried APRS messages.
+ *
+ * @details APRS clients resend a message until it is acked, so one query can
+ * arrive several times. The table remembers a hash of (source callsign,
+ * message ID) for APRS_DEDUPE_TTL_MS so a retry can be recognised and re-acked
+ * without producing a second reply.
+ *
+ * The table is a fixed array of APRS_DEDUPE_SLOTS entries with open addressing
+ * and a bounded linear probe. Expired entries are reused in place; when every
+ * slot in the probe window is live the oldest one is evicted.
+ */
+
+#ifndef APRS_DEDUPE_H
+#define APRS_DEDUPE_H
+
+#include <stdint.h>		// uint32_t
+#include "aprsParser.h" // APRSField
+
+const int APRS_DEDUPE_SLOTS = 32;						 // table size, power of two
+const int APRS_DEDUPE_PROBES = 8;						 // slots searched per key
+const unsigned long APRS_DEDUPE_TTL_MS = 10UL * 60 * 1000; // remember a message for 10 minutes
+
+class APRSDedupeTable
+{
+public:
+	explicit APRSDedupeTable(unsigned long ttlMs = APRS_DEDUPE_TTL_MS);
+
+	bool seen(const APRSField &source, const APRSField &msgID, unsigned long now);
+	void clear();
+
+	unsigned long hits() const { return _hits; }
+	unsigned long misses() const { return _misses; }
+	unsigned long evictions() const { return _evictions; }
+
+private:
+	struct Slot
+	{
+		uint32_t key;	// 0 marks an empty slot
+		uint32_t stamp; // millis() when last seen
+	};
+
+	static uint32_t hashKey(const APRSField &source, const APRSField &msgID);
+	bool expired(const Slot &slot, unsigned long now) const;
+
+	Slot _slots[APRS_DEDUPE_SLOTS];
+	unsigned long _ttlMs;
+	unsigned long _hits;
+	unsigned long _misses;
+	unsigned long _evictions;
+};
+
+#endif // APRS_DEDUPE_H
+// End of file
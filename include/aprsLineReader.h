@@ -0,0 +1,101 @@
+/**
+ * @file aprsLineReader.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Fixed-buffer line reader for the APRS-IS receive path.
+ *
+ * @details Bytes are pulled from the APRS-IS connection into one preallocated
+ * buffer of APRS_BUFFER_SIZE bytes. Complete lines are handed to the caller as
+ * pointer/length views into that buffer, so no String is allocated per packet.
+ * Lines longer than the buffer are truncated, counted and the remainder of the
+ * line is discarded instead of growing the buffer.
+ *
+ * A view stays valid until the next call to readLine() or nextLine().
+ */
+
+#ifndef APRS_LINE_READER_H
+#define APRS_LINE_READER_H
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t
+
+const int APRS_BUFFER_SIZE = 513; // APRS buffer size, must be at least 512 bytes + 1 for null terminator
+
+/**
+ * @brief View of one received line.
+ *
+ * text points into the reader buffer and is null-terminated with the
+ * CR/LF terminator removed.
+ */
+struct APRSLine
+{
+	const char *text = ""; // line text, null-terminated
+	size_t length = 0;	   // characters in text
+	bool truncated = false; // line was longer than the buffer
+};
+
+class APRSLineReader
+{
+public:
+	APRSLineReader();
+
+	void reset(); // discard buffered bytes, e.g. on a new connection
+
+	/**
+	 * @brief Reads the next complete line from a byte source.
+	 *
+	 * Uses only the bytes the source already has available, so it never waits.
+	 * Source needs available() and read(uint8_t *, size_t), as WiFiClient has.
+	 *
+	 * @return true if a line was returned in line.
+	 */
+	template <typename Source>
+	bool readLine(Source &src, APRSLine &line)
+	{
+		while (!nextLine(line))
+		{
+			compact();
+			int avail = src.available();
+			if (avail <= 0)
+			{
+				return false;
+			}
+			size_t want = spaceLeft();
+			if ((size_t)avail < want)
+			{
+				want = (size_t)avail;
+			}
+			int got = src.read((uint8_t *)fillPointer(), want);
+			if (got <= 0)
+			{
+				return false;
+			}
+			commit((size_t)got);
+		}
+		return true;
+	}
+
+	bool nextLine(APRSLine &line); // frame a line from bytes already buffered
+
+	char *fillPointer();	   // where the next received bytes go
+	size_t spaceLeft() const;  // bytes that fit at fillPointer()
+	void commit(size_t count); // count bytes were written at fillPointer()
+	void compact();			   // reclaim space taken by consumed lines
+
+	unsigned long linesRead() const { return _linesRead; }
+	unsigned long truncatedLines() const { return _truncatedLines; }
+	unsigned long bytesRead() const { return _bytesRead; }
+
+private:
+	char _buf[APRS_BUFFER_SIZE];
+	size_t _tail;		 // start of the first unconsumed line
+	size_t _scan;		 // bytes before this are known to hold no newline
+	size_t _head;		 // end of received data
+	bool _discarding;	 // skipping the rest of a truncated line
+	unsigned long _linesRead;
+	unsigned long _truncatedLines;
+	unsigned long _bytesRead;
+};
+
+#endif // APRS_LINE_READER_H
+// End of file
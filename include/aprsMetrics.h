@@ -0,0 +1,93 @@
+/**
+ * @file aprsMetrics.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief On-device APRS traffic counters and timing instrumentation.
+ *
+ * @details Event counters and min/avg/max timings live in fixed storage with
+ * no heap use. Traffic counters that other modules already keep (receive
+ * buffer, transmit queue, responder, sessions) are read from them when a
+ * snapshot is taken, so recording costs nothing on the packet path.
+ *
+ * getAPRSMetrics() fills a plain struct that any output (serial, display,
+ * telemetry) can read; printAPRSMetrics() is the serial one.
+ */
+
+#ifndef APRS_METRICS_H
+#define APRS_METRICS_H
+
+#include <Arduino.h> // for micros(), Print
+
+//! Timed code paths
+enum MetricTimer
+{
+	METRIC_POLL_APRS,
+	METRIC_UPDATE_APRS,
+	METRIC_PICK_APHORISM,
+	METRIC_TIMER_COUNT
+};
+
+//! Events counted here rather than in their own module
+enum MetricCounter
+{
+	METRIC_CONNECT_FAILED,
+	METRIC_LOGON_VERIFIED,
+	METRIC_LOGON_UNVERIFIED,
+	METRIC_LOGON_TIMEOUT,
+	METRIC_COUNTER_COUNT
+};
+
+//! Timing of one code path in microseconds
+struct MetricTiming
+{
+	unsigned long count = 0;
+	unsigned long minUs = 0;
+	unsigned long maxUs = 0;
+	unsigned long totalUs = 0;
+
+	unsigned long avgUs() const { return count ? totalUs / count : 0; }
+};
+
+struct APRSMetricsSnapshot
+{
+	unsigned long uptimeMs;
+	// inbound
+	unsigned long packetsIn;	// lines received
+	unsigned long bytesIn;		// bytes received
+	unsigned long fastRejected; // not addressed to CALLSIGN
+	unsigned long parsed;		// parsed successfully
+	unsigned long parseErrors;	// malformed packets
+	unsigned long truncated;	// lines longer than the receive buffer
+	// outbound
+	unsigned long packetsOut; // lines written
+	unsigned long bytesOut;	  // bytes written
+	unsigned long segments;	  // write() calls
+	unsigned long txDrops;	  // lines refused by the transmit queue
+	unsigned long replyDrops; // queries lost to a full reply queue
+	int txDepth;			  // lines waiting now
+	// connection
+	unsigned long reconnects;
+	unsigned long counters[METRIC_COUNTER_COUNT];
+	MetricTiming timing[METRIC_TIMER_COUNT];
+};
+
+void metricsCount(MetricCounter counter);
+void metricsRecord(MetricTimer timer, unsigned long elapsedUs);
+void getAPRSMetrics(APRSMetricsSnapshot &snapshot);
+void printAPRSMetrics(Print &out);
+void reportAPRSMetrics();
+
+//! Times the enclosing scope into a MetricTimer
+class MetricScope
+{
+public:
+	explicit MetricScope(MetricTimer timer) : _timer(timer), _start(micros()) {}
+	~MetricScope() { metricsRecord(_timer, micros() - _start); }
+
+private:
+	MetricTimer _timer;
+	unsigned long _start;
+};
+
+#endif // APRS_METRICS_H
+// End of file
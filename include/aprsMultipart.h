@@ -0,0 +1,66 @@
+/**
+ * @file aprsMultipart.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Sends texts longer than one APRS message as numbered parts.
+ *
+ * @details splitAPRSText() breaks a text at word boundaries into parts that
+ * each fit APRS_MESSAGE_MAX with a "k/n " marker in front; a word longer
+ * than a part is cut. A text that fits is one part without a marker.
+ *
+ * sendAPRSText() sends the first part at once and holds the rest in a small
+ * fixed queue; serviceAPRSMultipart() releases one part of each text every
+ * APRS_MULTIPART_SPACING milliseconds, so the parts go out in order through
+ * the transmit queue without flooding it. Pending parts are dropped with the
+ * connection.
+ */
+
+#ifndef APRS_MULTIPART_H
+#define APRS_MULTIPART_H
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t
+
+#ifndef APRS_MULTIPART_SPACING
+#define APRS_MULTIPART_SPACING 5000L // milliseconds between parts of one text
+#endif
+
+const int APRS_MULTIPART_TEXT_MAX = 160; // longest text that can be sent
+const int APRS_MULTIPART_PARTS_MAX = 9;	 // parts of one text, one digit in the marker
+const int APRS_MULTIPART_MARKER = 4;	 // "k/n "
+const int APRS_MULTIPART_QUEUE_SIZE = 4; // texts with parts still to send
+
+//! Part of a text, as a view into it
+struct APRSTextPart
+{
+	uint8_t offset; // first character
+	uint8_t length; // characters
+};
+
+//! How the parts are addressed
+enum APRSMultipartKind
+{
+	MULTIPART_MESSAGE, // to a callsign, without a message ID
+	MULTIPART_BULLETIN // as bulletin or announcement ID
+};
+
+//! Multi-part counters
+struct APRSMultipartStats
+{
+	unsigned long texts = 0;   // texts sent or queued
+	unsigned long split = 0;   // of those, texts sent in more than one part
+	unsigned long parts = 0;   // parts handed to the transmit path
+	unsigned long refused = 0; // texts too long, or the queue was full
+	unsigned long dropped = 0; // parts lost with the connection
+};
+
+extern APRSMultipartStats multipartStats;
+
+int splitAPRSText(const char *text, size_t length, APRSTextPart *parts, int maxParts);
+bool aprsMultipartSlotFree();
+bool sendAPRSText(APRSMultipartKind kind, const char *to, const char *text, size_t length);
+void serviceAPRSMultipart();
+void clearAPRSMultipart();
+
+#endif // APRS_MULTIPART_H
+// End of file
@@ -0,0 +1,59 @@
+/**
+ * @file aprsPacketBuilder.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Fixed-buffer builder for outbound APRS-IS lines.
+ *
+ * @details A packet is assembled field by field in one buffer of
+ * APRS_PACKET_SIZE characters, the longest line the transmit queue accepts,
+ * so no String is allocated while building. Each append is bounded and checks
+ * the APRS101 width of its field: the source callsign, the 9-character
+ * addressee, the 67-character message text and the 5-character message ID.
+ *
+ * The first append that does not fit marks the packet failed and later
+ * appends do nothing, so a packet can be built with a chain of appends and
+ * checked once with ok() before it is sent.
+ */
+
+#ifndef APRS_PACKET_BUILDER_H
+#define APRS_PACKET_BUILDER_H
+
+#include <stddef.h>		 // size_t
+#include "aprsTxQueue.h" // APRS_TX_LINE_SIZE
+
+const int APRS_PACKET_SIZE = APRS_TX_LINE_SIZE; // longest packet, without terminator
+const int APRS_CALLSIGN_MAX = 9;				// callsign with SSID, e.g. "W4KRL-15", pg 12
+
+class APRSPacketBuilder
+{
+public:
+	APRSPacketBuilder();
+
+	void reset(); // empty the packet and clear a failure
+
+	bool append(char c);
+	bool append(const char *text);
+	bool append(const char *text, size_t length);
+	bool appendPadded(const char *text, size_t width);	   // left-justified, space-filled, cut to width
+	bool appendZeroPadded(long value, int width);		   // e.g. 77 to "077", fails if wider
+	bool appendLocation(float lat, float lon);			   // DDmm.mmN/DDDmm.mmW
+	bool header(const char *source);					   // SOURCE>APRS,TCPIP*:
+	bool appendAddressee(const char *addressee);		   // :ADDRESSEE:
+	bool appendMessageText(const char *text);			   // at most APRS_MESSAGE_MAX characters
+	bool appendMessageText(const char *text, size_t length);
+	bool appendMessageId(const char *id);				   // {ID, at most APRS_MSG_ID_MAX characters
+
+	bool ok() const { return !_failed; }
+	const char *c_str() const { return _buf; }
+	size_t length() const { return _length; }
+
+private:
+	bool fail();
+
+	char _buf[APRS_PACKET_SIZE + 1];
+	size_t _length;
+	bool _failed;
+};
+
+#endif // APRS_PACKET_BUILDER_H
+// End of file
@@ -0,0 +1,79 @@
+/**
+ * @file aprsParser.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Single-pass parser for TNC2-format APRS-IS packets.
+ *
+ * @details A packet line of the form SRC>DST,PATH:payload is split into views
+ * of the original line. Nothing is copied and the line is not modified, so the
+ * views are only valid as long as the line is.
+ *
+ * The payload is classified by its APRS data type identifier. For messages the
+ * addressee, text and message ID are split out as well.
+ */
+
+#ifndef APRS_PARSER_H
+#define APRS_PARSER_H
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint16_t
+
+// APRS Data Type Identifiers
+// page 17 http://www.aprs.org/doc/APRS101.PDF
+const char APRS_ID_POSITION_NO_TIMESTAMP = '!';
+const char APRS_ID_TELEMETRY = 'T';
+const char APRS_ID_WEATHER = '_';
+const char APRS_ID_MESSAGE = ':';
+const char APRS_ID_QUERY = '?';
+const char APRS_ID_STATUS = '>';
+const char APRS_ID_USER_DEF = '{';
+const char APRS_ID_COMMENT = '#';
+
+const int APRS_ADDRESSEE_WIDTH = 9; // message addressee field width, pg 71
+const int APRS_MESSAGE_MAX = 67;	// message text limit, pg 71
+const int APRS_MSG_ID_MAX = 5;		// message ID limit, pg 71
+
+//! Payload classes, one per data type identifier above
+enum APRSPacketType
+{
+	APRS_TYPE_OTHER,
+	APRS_TYPE_POSITION,
+	APRS_TYPE_TELEMETRY,
+	APRS_TYPE_WEATHER,
+	APRS_TYPE_MESSAGE,
+	APRS_TYPE_QUERY,
+	APRS_TYPE_STATUS,
+	APRS_TYPE_USER_DEF,
+	APRS_TYPE_COMMENT
+};
+
+//! View of part of a packet line; text is not null-terminated
+struct APRSField
+{
+	const char *text = "";
+	uint16_t length = 0;
+
+	bool equals(const char *str) const; // exact match with a C string
+};
+
+struct APRSPacket
+{
+	APRSField source;	   // originating station
+	APRSField destination; // tocall
+	APRSField path;		   // digipeater/q-construct path, may be empty
+	APRSField payload;	   // everything after the first ':'
+	char dataType = 0;	   // first payload character
+	APRSPacketType type = APRS_TYPE_OTHER;
+
+	// only set for APRS_TYPE_MESSAGE
+	APRSField addressee; // trailing pad spaces removed
+	APRSField text;		 // message text without the ID
+	APRSField msgID;	 // message number after '{', empty if none
+};
+
+APRSPacketType aprsClassify(char dataType);
+bool parseAPRSPacket(const char *line, size_t length, APRSPacket &packet);
+bool aprsIsAddressedTo(const char *line, size_t length, const char *paddedCall);
+
+#endif // APRS_PARSER_H
+// End of file
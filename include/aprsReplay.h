@@ -0,0 +1,148 @@
+/**
+ * @file aprsReplay.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Replays a captured APRS-IS stream through the receive path.
+ *
+ * @details A capture holds one record per received line:
+ *
+ *     <millis>\t<line>\n
+ *
+ * APRSReplaySource reads such a capture from any backing store and presents the
+ * original lines, CR LF terminated, through available() and read() just like
+ * the WiFiClient does, so APRSLineReader and everything after it run unchanged.
+ *
+ * In real-time mode each line is released when as much time has passed since
+ * the start of the replay as had passed since the first captured line. A
+ * stamp earlier than the one before it, as from a capture made across a
+ * reboot, is released at once and the spacing is measured from it. In fast
+ * mode lines are released as soon as they are read.
+ *
+ * Backing needs available() and read(uint8_t *, size_t): a LittleFS File on
+ * the device, or a small stdio adapter on the host. Records that do not fit
+ * the line reader buffer or have no tab are skipped and counted.
+ */
+
+#ifndef APRS_REPLAY_H
+#define APRS_REPLAY_H
+
+#include <stdlib.h> // strtoul
+#include <string.h> // memcpy, memchr
+#include "aprsLineReader.h"
+
+template <typename Backing>
+class APRSReplaySource
+{
+public:
+	typedef unsigned long (*Clock)(); // millis() or a host equivalent
+
+	APRSReplaySource(Backing &backing, Clock clock, bool realTime)
+		: _backing(backing), _clock(clock), _realTime(realTime),
+		  _started(false), _loaded(false), _ended(false), _firstStamp(0), _startMs(0),
+		  _stamp(0), _pending(0), _length(0), _sent(0), _records(0), _badRecords(0)
+	{
+	}
+
+	//! Bytes of released lines ready to read.
+	int available()
+	{
+		if (_sent == _length && !nextRecord())
+		{
+			return 0;
+		}
+		return (int)(_length - _sent);
+	}
+
+	int read(uint8_t *buf, size_t size)
+	{
+		int avail = available();
+		size_t n = ((size_t)avail < size) ? (size_t)avail : size;
+		memcpy(buf, _out + _sent, n);
+		_sent += n;
+		return (int)n;
+	}
+
+	bool finished() const { return _ended && !_loaded && _sent == _length; }
+	unsigned long records() const { return _records; }
+	unsigned long badRecords() const { return _badRecords; }
+
+private:
+	//! Loads the next capture record and releases it when due.
+	bool nextRecord()
+	{
+		if (!_loaded)
+		{
+			APRSLine record;
+			for (;;)
+			{
+				if (!_recordReader.readLine(_backing, record))
+				{
+					_ended = true;
+					return false;
+				}
+				const char *tab = (const char *)memchr(record.text, '\t', record.length);
+				if (tab == nullptr || record.truncated)
+				{
+					_badRecords++;
+					continue;
+				}
+				size_t length = record.length - (tab + 1 - record.text);
+				if (length + 2 > sizeof(_out))
+				{
+					_badRecords++;
+					continue;
+				}
+				unsigned long previous = _stamp;
+				_stamp = strtoul(record.text, nullptr, 10);
+				if (_started && (long)(_stamp - previous) < 0)
+				{
+					_firstStamp = _stamp; // the clock went back: start over from here
+					_startMs = _clock();
+				}
+				memcpy(_out, tab + 1, length);
+				_out[length++] = '\r';
+				_out[length++] = '\n';
+				_pending = length;
+				_loaded = true;
+				break;
+			}
+		}
+
+		if (!_started)
+		{
+			_started = true;
+			_firstStamp = _stamp;
+			_startMs = _clock();
+		}
+		if (_realTime && _clock() - _startMs < _stamp - _firstStamp)
+		{
+			return false; // not due yet
+		}
+
+		_length = _pending;
+		_sent = 0;
+		_loaded = false;
+		_records++;
+		return true;
+	}
+
+	Backing &_backing;
+	Clock _clock;
+	bool _realTime;
+	APRSLineReader _recordReader; // frames capture records
+	bool _started;
+	bool _loaded; // a record is waiting for its release time
+	bool _ended;
+	unsigned long _firstStamp; // capture time of the first record
+	unsigned long _startMs;	   // replay clock when it was released
+	unsigned long _stamp;	   // capture time of the loaded record
+	char _out[APRS_BUFFER_SIZE + 2];
+	size_t _pending; // bytes of the loaded record
+	size_t _length;	 // bytes of the released line
+	size_t _sent;	 // bytes of it already read
+	unsigned long _records;
+	unsigned long _badRecords;
+};
+
+#endif // APRS_REPLAY_H
+// End of file
@@ -0,0 +1,49 @@
+/**
+ * @file aprsResponder.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Answers APRS messages addressed to CALLSIGN with an aphorism.
+ *
+ * @details Incoming queries are queued by queueAPRSReply() while packets are
+ * being read and answered by serviceAPRSResponder() later in the same
+ * pollAPRS() pass: an ack if the message carried a {msgID}, then the next
+ * aphorism from pickAphorism(). The time from receipt to reply is measured.
+ *
+ * The (source, msgID) pair is recorded as answered when the query is queued,
+ * so a retry is only re-acked. The reply therefore must not be lost: while
+ * every multi-part slot is busy a single-message aphorism is sent instead,
+ * and failing that the reply stays queued for a later pass.
+ */
+
+#ifndef APRS_RESPONDER_H
+#define APRS_RESPONDER_H
+
+#include <Arduino.h>	// for micros()
+#include "aprsDedupe.h" // for APRSDedupeTable
+#include "aprsParser.h" // for APRSPacket
+
+const int APRS_REPLY_QUEUE_SIZE = 4; // queries held between read and reply
+const int APRS_REPLY_PICKS_MAX = 8;	 // aphorisms tried for one that fits while multi-part slots are busy
+
+//! Responder counters; latencies in microseconds
+struct APRSResponderStats
+{
+	unsigned long queries = 0;		  // messages queued for a reply
+	unsigned long retries = 0;		  // duplicates queued for an ack only
+	unsigned long acks = 0;			  // acks sent
+	unsigned long replies = 0;		  // aphorisms sent
+	unsigned long dropped = 0;		  // queries lost to a full queue
+	unsigned long deferred = 0;		  // passes a reply waited for a multi-part slot
+	unsigned long lastLatencyUs = 0;  // receipt to reply, last query
+	unsigned long maxLatencyUs = 0;	  // receipt to reply, worst case
+	unsigned long totalLatencyUs = 0; // sum for the average
+};
+
+extern APRSResponderStats responderStats;
+extern APRSDedupeTable aprsDedupe; // hit/miss/eviction counters
+
+bool queueAPRSReply(const APRSPacket &packet, unsigned long rxMicros);
+void serviceAPRSResponder();
+
+#endif // APRS_RESPONDER_H
+// End of file
@@ -0,0 +1,80 @@
+/**
+ * @file aprsServerList.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Ordered APRS-IS server list with per-endpoint backoff and latency tracking.
+ *
+ * @details Each endpoint keeps a rolling record of its last APRS_LATENCY_SAMPLES
+ * connect times and logresp latencies. select() returns the endpoint to try
+ * next: among those not backing off, the one with the fewest consecutive
+ * failures, then the lowest average connect plus logresp time, then the
+ * earliest in the list. Endpoints never measured rank after measured ones so
+ * a known fast server is not given up for an untried one.
+ *
+ * A failure puts the endpoint into exponential backoff with jitter. A
+ * verified logon clears it.
+ *
+ * The list is supplied by the caller, so it can point at local stand-in
+ * servers for testing.
+ */
+
+#ifndef APRS_SERVER_LIST_H
+#define APRS_SERVER_LIST_H
+
+#include <stdint.h> // uint16_t, uint32_t
+
+const int APRS_MAX_SERVERS = 4;								// endpoints tracked
+const int APRS_LATENCY_SAMPLES = 4;							// rolling window per endpoint
+const unsigned long APRS_BACKOFF_BASE_MS = 2000;			// first retry delay
+const unsigned long APRS_BACKOFF_MAX_MS = 5UL * 60 * 1000; // longest retry delay
+
+struct APRSEndpoint
+{
+	const char *host;
+	uint16_t port;
+};
+
+//! Health record of one endpoint; times in milliseconds
+struct APRSEndpointHealth
+{
+	unsigned long attempts = 0;	 // connection attempts
+	unsigned long logons = 0;	 // verified logons
+	unsigned long failures = 0;	 // failed attempts and dropped sessions
+	uint8_t consecutive = 0;	 // failures since the last verified logon
+	unsigned long retryAt = 0;	 // millis() when the backoff ends
+	uint16_t connectMs[APRS_LATENCY_SAMPLES] = {};
+	uint16_t logrespMs[APRS_LATENCY_SAMPLES] = {};
+	uint8_t connectSamples = 0; // valid entries in connectMs
+	uint8_t logrespSamples = 0; // valid entries in logrespMs
+	uint8_t connectNext = 0;	// next connectMs entry to overwrite
+	uint8_t logrespNext = 0;	// next logrespMs entry to overwrite
+};
+
+class APRSServerList
+{
+public:
+	APRSServerList();
+
+	void begin(const APRSEndpoint *list, int count);
+	int select(unsigned long now) const;
+	unsigned long nextRetry(unsigned long now) const;
+
+	void recordAttempt(int index);
+	void recordConnect(int index, unsigned long connectMs);
+	void recordLogon(int index, unsigned long logrespMs);
+	void recordFailure(int index, unsigned long now, uint32_t random);
+
+	int count() const { return _count; }
+	const APRSEndpoint &endpoint(int index) const { return _list[index]; }
+	const APRSEndpointHealth &health(int index) const { return _health[index]; }
+	unsigned long avgConnectMs(int index) const;
+	unsigned long avgLogrespMs(int index) const;
+
+private:
+	const APRSEndpoint *_list;
+	int _count;
+	APRSEndpointHealth _health[APRS_MAX_SERVERS];
+};
+
+#endif // APRS_SERVER_LIST_H
+// End of file
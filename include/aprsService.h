@@ -5,19 +5,93 @@
  * @date 2025-05-14
  */
 
-#include <Arduino.h> // for String
+#ifndef APRS_SERVICE_H
+#define APRS_SERVICE_H
 
-// Bulletin tracking flags
-extern bool amBulletinSent;
-extern bool pmBulletinSent;
+#include <Arduino.h>		// for String
+#include "aprsLineReader.h" // for APRSLine
+#include "aprsPacketBuilder.h" // for APRSPacketBuilder
+#include "aprsServerList.h" // for APRSServerList
+#include "aprsTxQueue.h"	// for APRSTxQueue
 
-bool readAPRSPacket(String &packet);
+// Receive buffer and counters
+extern APRSLineReader aprsReader;
+extern unsigned long aprsFastRejected;
+extern unsigned long aprsPacketsParsed;
+extern unsigned long aprsParseErrors;
+
+// Transmit queue, for depth, bytes pending and time-in-queue
+extern APRSTxQueue aprsTx;
+
+//! APRS-IS session history; times in milliseconds
+struct APRSSessionStats
+{
+	unsigned long sessions = 0;			// logons verified
+	unsigned long reconnects = 0;		// logons after the first
+	unsigned long sessionStart = 0;		// millis() when the current session began
+	unsigned long lastSessionMs = 0;	// length of the last finished session
+	unsigned long longestSessionMs = 0; // longest finished session
+	unsigned long totalSessionMs = 0;	// sum of finished sessions
+};
+extern APRSSessionStats aprsSessions;
+unsigned long aprsSessionMillis();
+
+// Server-side filter
+const int APRS_FILTER_SIZE = 128; // longest filter + 1
+
+//! Inbound volume around filter changes
+struct APRSFilterStats
+{
+	unsigned long changes = 0;			  // filter changes since boot
+	unsigned long beforeBytesPerHour = 0; // rate under the filter replaced last
+	unsigned long afterBytesPerHour = 0;  // rate under the new one, one window later
+	bool afterPending = false;			  // afterBytesPerHour not sampled yet
+	bool runtimeApplied = false;		  // APRS_RUNTIME_FILTER has been sent
+};
+extern APRSFilterStats aprsFilterStats;
+extern char aprsFilter[APRS_FILTER_SIZE];
+bool setAPRSFilter(const char *filter);
+unsigned long aprsFilterBytesPerHour();
+
+// Server list, for per-endpoint connect and logresp latency
+extern APRSServerList aprsServers;
+void setAPRSServers(const APRSEndpoint *list, int count);
+
+bool readAPRSPacket(APRSLine &packet);
+void processServerMessage(const APRSLine &line);
+void processAPRSPacket(const APRSLine &line);
 void postToAPRS(String message);
-void APRSsendBulletin(String msg, String ID);
-void processBulletins();
+void postToAPRS(const char *line, size_t length);
+void serviceAPRSTx();
+void APRSsendBulletin(const char *msg, const char *ID);
+void APRSsendACK(const char *recipient, const char *msgID);
+void APRSsendMessage(const char *recipient, const char *message);
+
+// Packet formatters, into a fixed buffer; false if a field does not fit
+bool buildAPRSHeaders();
+bool APRSbuildBulletin(APRSPacketBuilder &packet, const char *message, const char *ID);
+bool APRSbuildAck(APRSPacketBuilder &packet, const char *recipient, const char *msgID);
+bool APRSbuildMessage(APRSPacketBuilder &packet, const char *recipient, const char *message);
+bool APRSbuildLogon(APRSPacketBuilder &packet);
+
+// The same as String, for display and debug output
+String APRSformatBulletin(const char *message, const char *ID);
+String APRSpadder(float value, int width);
+String APRSpadCall(const char *callSign);
+String APRSlocation(float lat, float lon);
+String APRSlogonString();
+// Connection and logon, stepped by updateAPRS(). Nothing waits for the server
+// except the TCP connect: the name lookup blocks at most APRS_DNS_SLICE (5 ms)
+// per pass and is retried, but WiFiClient::connect() cannot be split across
+// passes on this core. It blocks for up to APRS_CONNECT_MARGIN (3) times that
+// server's usual connect time, at least 20 ms, and up to APRS_CONNECT_TIMEOUT
+// (1 s) for a server not yet reached or whose last attempt failed.
+void beginAPRS();
 void pollAPRS();
-bool verifyLogonStatus();
 void connectToAPRSserver();
+void resolveAPRSserver();
 void updateAPRS();
 bool connectToAPRS();
 
+#endif // APRS_SERVICE_H
+// End of file
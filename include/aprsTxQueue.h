@@ -0,0 +1,113 @@
+/**
+ * @file aprsTxQueue.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Non-blocking transmit queue for outbound APRS-IS lines.
+ *
+ * @details Lines are formatted by the caller and copied, with their CR LF
+ * terminator, into a fixed ring of APRS_TX_QUEUE_DEPTH slots. service() is
+ * called from loop() and writes only as much as the connection will take
+ * without blocking, as reported by availableForWrite().
+ *
+ * Lines are written as segments: every line already queued, up to
+ * APRS_TX_SEGMENT_SIZE bytes, is copied into one contiguous buffer and handed
+ * to a single write(), so an ack and its reply leave in one TCP segment
+ * instead of the four that println() would produce. A segment that is only
+ * partly accepted is resumed from where it stopped on the next call.
+ *
+ * Queue depth, bytes pending, time spent in the queue and bytes per segment
+ * are tracked so backpressure from the server connection can be seen.
+ */
+
+#ifndef APRS_TX_QUEUE_H
+#define APRS_TX_QUEUE_H
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t, uint16_t, uint32_t
+
+const int APRS_TX_QUEUE_DEPTH = 8;		   // lines waiting to be sent
+const int APRS_TX_LINE_SIZE = 192;		   // longest line, without terminator
+const int APRS_TX_SEGMENT_SIZE = 512;	   // most bytes handed to one write()
+const unsigned long APRS_TX_COALESCE_MS = 0; // hold a lone line this long for company, 0 = send at once
+
+//! Transmit counters; times in milliseconds
+struct APRSTxStats
+{
+	unsigned long queued = 0;		   // lines accepted
+	unsigned long sent = 0;			   // lines completely written
+	unsigned long dropped = 0;		   // lines refused: queue full or too long
+	unsigned long segments = 0;		   // write() calls that took data
+	unsigned long partialWrites = 0;   // writes that took only part of a segment
+	unsigned long bytesSent = 0;	   // bytes written including terminators
+	int maxDepth = 0;				   // deepest the queue has been
+	unsigned long maxQueueMs = 0;	   // longest time a line waited
+	unsigned long totalQueueMs = 0;	   // sum for the average
+};
+
+class APRSTxQueue
+{
+public:
+	APRSTxQueue();
+
+	bool enqueue(const char *line, size_t length, unsigned long now);
+	void clear(); // drop everything, e.g. when the connection is lost
+
+	/**
+	 * @brief Writes queued lines to a sink without blocking.
+	 *
+	 * Sink needs availableForWrite() and write(const uint8_t *, size_t), as
+	 * WiFiClient has. Stops as soon as the sink has no room.
+	 *
+	 * @param now Current millis(), for the time-in-queue figures.
+	 */
+	template <typename Sink>
+	void service(Sink &sink, unsigned long now)
+	{
+		while (_segLength > 0 || stage(now))
+		{
+			int room = sink.availableForWrite();
+			if (room <= 0)
+			{
+				return;
+			}
+			size_t left = _segLength - _segSent;
+			size_t offer = (left < (size_t)room) ? left : (size_t)room;
+			size_t written = sink.write(_segment + _segSent, offer);
+			if (written == 0)
+			{
+				return;
+			}
+			advance(written, left, now);
+		}
+	}
+
+	int depth() const { return _count; }
+	size_t bytesPending() const { return _bytesPending; }
+	const APRSTxStats &stats() const { return _stats; }
+
+private:
+	struct Slot
+	{
+		char text[APRS_TX_LINE_SIZE + 2]; // line and CR LF
+		uint16_t length;				  // bytes in text
+		uint32_t queuedAt;				  // millis() when queued
+	};
+
+	bool stage(unsigned long now);
+	void advance(size_t written, size_t left, unsigned long now);
+
+	Slot _slots[APRS_TX_QUEUE_DEPTH];
+	int _head;	// oldest line
+	int _count; // lines queued, including those staged
+	size_t _bytesPending;
+
+	uint8_t _segment[APRS_TX_SEGMENT_SIZE]; // lines being written
+	size_t _segLength;						// bytes in _segment, 0 if none staged
+	size_t _segSent;						// bytes of _segment already written
+	int _segLines;							// queued lines copied into _segment
+
+	APRSTxStats _stats;
+};
+
+#endif // APRS_TX_QUEUE_H
+// End of file
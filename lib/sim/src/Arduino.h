@@ -0,0 +1,114 @@
+/**
+ * @file Arduino.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for the ESP8266 Arduino core.
+ *
+ * @details Provides the part of the core the firmware uses: String, Print,
+ * Stream, Serial, the time functions, random numbers, ESP.random() and RTC
+ * user memory, pins and the PROGMEM
+ * helpers. Time comes from the simulator clock (see sim.h), so millis() and
+ * micros() can run faster than the wall clock.
+ *
+ * unsigned long is 64 bits on the host, so millis() does not wrap after
+ * 49.7 days as it does on the device.
+ */
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm> // std::min, std::max
+#include <cmath>	 // std::abs
+
+#include "WString.h"
+#include "Print.h"
+
+using std::abs;
+using std::max;
+using std::min;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// ******************* PROGMEM *************************
+// flash and RAM share one address space on the host
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+#define memcpy_P memcpy
+#define strncpy_P strncpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ******************* Pins ****************************
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x00
+#define OUTPUT 0x01
+#define INPUT_PULLUP 0x02
+#define LED_BUILTIN 2
+#define A0 17
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+// ******************* Time ****************************
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// ******************* Random **************************
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// ******************* ESP *****************************
+//! The part of the core's EspClass the firmware uses
+class EspClass
+{
+public:
+	uint32_t random(); // hardware random number generator
+	bool rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size);  // offset in 4-byte blocks
+	bool rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size); // size in bytes
+};
+
+extern EspClass ESP;
+
+// ******************* Serial **************************
+class HardwareSerial : public Stream
+{
+public:
+	void begin(unsigned long baud);
+	int available() override { return 0; }
+	int read() override { return -1; }
+	int peek() override { return -1; }
+	void flush() override;
+	size_t write(uint8_t c) override;
+	size_t write(const uint8_t *buffer, size_t size) override;
+	using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// firmware entry points
+void setup();
+void loop();
+
+#endif // SIM_ARDUINO_H
+// End of file
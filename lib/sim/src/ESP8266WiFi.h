@@ -0,0 +1,72 @@
+/**
+ * @file ESP8266WiFi.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for the ESP8266 WiFi station.
+ *
+ * @details The host network is always up, so begin() connects at once and
+ * status() is WL_CONNECTED. hostByName() answers from the host resolver,
+ * and with 127.0.0.1 for a host that --aprs-map or --aprs sends elsewhere.
+ */
+
+#ifndef SIM_ESP8266_WIFI_H
+#define SIM_ESP8266_WIFI_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+enum wl_status_t
+{
+	WL_IDLE_STATUS = 0,
+	WL_NO_SSID_AVAIL = 1,
+	WL_SCAN_COMPLETED = 2,
+	WL_CONNECTED = 3,
+	WL_CONNECT_FAILED = 4,
+	WL_CONNECTION_LOST = 5,
+	WL_WRONG_PASSWORD = 6,
+	WL_DISCONNECTED = 7
+};
+
+enum WiFiMode_t
+{
+	WIFI_OFF = 0,
+	WIFI_STA = 1,
+	WIFI_AP = 2,
+	WIFI_AP_STA = 3
+};
+
+class ESP8266WiFiClass
+{
+public:
+	wl_status_t begin(const String &ssid, const String &passphrase)
+	{
+		(void)ssid;
+		(void)passphrase;
+		_status = WL_CONNECTED;
+		return _status;
+	}
+	bool mode(WiFiMode_t mode)
+	{
+		(void)mode;
+		return true;
+	}
+	wl_status_t status() const { return _status; }
+	bool isConnected() const { return _status == WL_CONNECTED; }
+	bool disconnect()
+	{
+		_status = WL_DISCONNECTED;
+		return true;
+	}
+	IPAddress localIP() const { return IPAddress(127, 0, 0, 1); }
+	int32_t RSSI() const { return -60; }
+	int hostByName(const char *host, IPAddress &result, uint32_t timeoutMs);
+
+private:
+	wl_status_t _status = WL_DISCONNECTED;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif // SIM_ESP8266_WIFI_H
+// End of file
@@ -0,0 +1,101 @@
+/**
+ * @file FS.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for the ESP8266 file system API.
+ *
+ * @details A File is a shared handle on a host stdio stream, so copies refer
+ * to the same open file as on the device. FS maps absolute LittleFS paths
+ * under a host directory.
+ */
+
+#ifndef SIM_FS_H
+#define SIM_FS_H
+
+#include <Arduino.h>
+#include <memory>
+
+namespace fs
+{
+
+enum SeekMode
+{
+	SeekSet = 0,
+	SeekCur = 1,
+	SeekEnd = 2
+};
+
+struct FSInfo
+{
+	size_t totalBytes;
+	size_t usedBytes;
+	size_t blockSize;
+	size_t pageSize;
+	size_t maxOpenFiles;
+	size_t maxPathLength;
+};
+
+class File : public Stream
+{
+public:
+	File() {}
+	File(FILE *file, const String &name);
+
+	int available() override;
+	int read() override;
+	int peek() override;
+	int read(uint8_t *buf, size_t size);
+	size_t write(uint8_t c) override { return write(&c, 1); }
+	size_t write(const uint8_t *buf, size_t size) override;
+	using Print::write;
+	int availableForWrite() override { return _file ? 4096 : 0; }
+	void flush() override;
+
+	bool seek(uint32_t pos, SeekMode mode = SeekSet);
+	size_t position() const;
+	size_t size() const;
+	void close();
+	const char *name() const { return _name.c_str(); }
+	const char *fullName() const { return _name.c_str(); }
+	bool isFile() const { return (bool)_file; }
+	explicit operator bool() const { return (bool)_file; }
+
+private:
+	std::shared_ptr<FILE> _file;
+	String _name;
+};
+
+class FS
+{
+public:
+	bool begin();
+	void end() {}
+	bool format();
+	bool info(FSInfo &info);
+
+	File open(const char *path, const char *mode);
+	File open(const String &path, const char *mode) { return open(path.c_str(), mode); }
+	bool exists(const char *path);
+	bool exists(const String &path) { return exists(path.c_str()); }
+	bool remove(const char *path);
+	bool remove(const String &path) { return remove(path.c_str()); }
+	bool rename(const char *from, const char *to);
+	bool rename(const String &from, const String &to) { return rename(from.c_str(), to.c_str()); }
+	bool mkdir(const char *path);
+
+private:
+	String hostPath(const char *path) const;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::FSInfo;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekMode;
+using fs::SeekSet;
+
+#endif // SIM_FS_H
+// End of file
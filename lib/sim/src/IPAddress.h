@@ -0,0 +1,32 @@
+/**
+ * @file IPAddress.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for the Arduino IPv4 address class.
+ */
+
+#ifndef SIM_IP_ADDRESS_H
+#define SIM_IP_ADDRESS_H
+
+#include <stdint.h>
+#include "Print.h"
+
+class IPAddress : public Printable
+{
+public:
+	IPAddress() : _octets{0, 0, 0, 0} {}
+	IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _octets{a, b, c, d} {}
+
+	uint8_t operator[](int index) const { return _octets[index]; }
+	String toString() const
+	{
+		return String(_octets[0]) + "." + String(_octets[1]) + "." + String(_octets[2]) + "." + String(_octets[3]);
+	}
+	size_t printTo(Print &p) const override { return p.print(toString()); }
+
+private:
+	uint8_t _octets[4];
+};
+
+#endif // SIM_IP_ADDRESS_H
+// End of file
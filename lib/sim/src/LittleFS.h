@@ -0,0 +1,19 @@
+/**
+ * @file LittleFS.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for LittleFS, mapped to the --fs directory.
+ *
+ * @details The directory defaults to data/, the same one uploadfs puts in
+ * the flash image, so the firmware reads the real aphorism file.
+ */
+
+#ifndef SIM_LITTLEFS_H
+#define SIM_LITTLEFS_H
+
+#include "FS.h"
+
+extern fs::FS LittleFS;
+
+#endif // SIM_LITTLEFS_H
+// End of file
@@ -0,0 +1,98 @@
+/**
+ * @file Print.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-ins for the Arduino Print, Printable and Stream classes.
+ *
+ * @details A subclass only has to provide write(uint8_t); print(), println()
+ * and printf() format as the core does. Stream adds the reading side used
+ * by files and network clients; reads never wait, there is no timeout.
+ */
+
+#ifndef SIM_PRINT_H
+#define SIM_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h> // strlen
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print;
+
+class Printable
+{
+public:
+	virtual ~Printable() {}
+	virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print
+{
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t *buffer, size_t size);
+	size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+	size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+	virtual int availableForWrite() { return 0; }
+	virtual void flush() {}
+
+	size_t print(const __FlashStringHelper *str) { return write(reinterpret_cast<const char *>(str)); }
+	size_t print(const String &str) { return write(str.c_str(), str.length()); }
+	size_t print(const char *str) { return write(str); }
+	size_t print(char c) { return write((uint8_t)c); }
+	size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+	size_t print(int value, int base = DEC) { return print((long)value, base); }
+	size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+	size_t print(long value, int base = DEC);
+	size_t print(unsigned long value, int base = DEC);
+	size_t print(long long value, int base = DEC) { return print((long)value, base); }
+	size_t print(unsigned long long value, int base = DEC) { return print((unsigned long)value, base); }
+	size_t print(double value, int digits = 2);
+	size_t print(const Printable &printable) { return printable.printTo(*this); }
+
+	size_t println() { return write("\r\n"); }
+	template <typename T>
+	size_t println(const T &value)
+	{
+		size_t n = print(value);
+		return n + println();
+	}
+	template <typename T>
+	size_t println(const T &value, int format)
+	{
+		size_t n = print(value, format);
+		return n + println();
+	}
+
+	size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print
+{
+public:
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() = 0;
+
+	void setTimeout(unsigned long timeout) { _timeout = timeout; }
+	unsigned long getTimeout() const { return _timeout; }
+
+	size_t readBytes(char *buffer, size_t length);
+	size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+	size_t readBytesUntil(char terminator, char *buffer, size_t length);
+	String readString();
+	String readStringUntil(char terminator);
+
+protected:
+	unsigned long _timeout = 1000; // kept for the callers, reads do not wait
+};
+
+#endif // SIM_PRINT_H
+// End of file
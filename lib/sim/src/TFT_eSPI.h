@@ -0,0 +1,135 @@
+/**
+ * @file TFT_eSPI.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for TFT_eSPI, rendering into an in-memory framebuffer.
+ *
+ * @details Pixels are RGB565 like the panel's. Free (GFX) fonts are drawn
+ * glyph by glyph; the built-in fonts are not, text in them only moves the
+ * cursor. simWriteScreen() (sim.h) saves the framebuffer as a PPM image.
+ */
+
+#ifndef SIM_TFT_ESPI_H
+#define SIM_TFT_ESPI_H
+
+#include <Arduino.h>
+
+#ifndef TFT_WIDTH
+#define TFT_WIDTH 128
+#endif
+#ifndef TFT_HEIGHT
+#define TFT_HEIGHT 128
+#endif
+
+// text datums
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define CL_DATUM 3
+#define MC_DATUM 4
+#define CC_DATUM 4
+#define MR_DATUM 5
+#define CR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+#define L_BASELINE 9
+#define C_BASELINE 10
+#define R_BASELINE 11
+
+// RGB565 colours
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_RED 0xF800
+#define TFT_MAGENTA 0xF81F
+#define TFT_YELLOW 0xFFE0
+#define TFT_ORANGE 0xFDA0
+#define TFT_WHITE 0xFFFF
+
+typedef struct
+{
+	uint32_t bitmapOffset; // into the font bitmap
+	uint8_t width, height; // bitmap size in pixels
+	uint8_t xAdvance;	   // cursor step
+	int8_t xOffset, yOffset; // from the cursor to the top left of the bitmap
+} GFXglyph;
+
+typedef struct
+{
+	uint8_t *bitmap;
+	GFXglyph *glyph;
+	uint16_t first, last; // character range
+	uint8_t yAdvance;	  // line height
+} GFXfont;
+
+class TFT_eSPI : public Print
+{
+public:
+	TFT_eSPI(int16_t width = TFT_WIDTH, int16_t height = TFT_HEIGHT);
+
+	void init();
+	void begin() { init(); }
+	void setRotation(uint8_t rotation);
+	uint8_t getRotation() const { return _rotation; }
+	int16_t width() const { return _width; }
+	int16_t height() const { return _height; }
+
+	void fillScreen(uint32_t color) { fillRect(0, 0, _width, _height, color); }
+	void drawPixel(int32_t x, int32_t y, uint32_t color);
+	uint16_t readPixel(int32_t x, int32_t y) const;
+	void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) { fillRect(x, y, w, 1, color); }
+	void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) { fillRect(x, y, 1, h, color); }
+	void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+	void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+	void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+	void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+	void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+	void drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+	void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+
+	void setFreeFont(const GFXfont *font);
+	void setTextFont(uint8_t font);
+	void setTextColor(uint16_t color) { _textColor = color; }
+	void setTextColor(uint16_t fg, uint16_t bg, bool fill = false);
+	void setTextDatum(uint8_t datum) { _datum = datum; }
+	void setTextSize(uint8_t size) { _textSize = size ? size : 1; }
+	void setTextWrap(bool wrapX, bool wrapY = false) { (void)wrapX, (void)wrapY; }
+	void setCursor(int16_t x, int16_t y);
+	int16_t getCursorX() const { return _cursorX; }
+	int16_t getCursorY() const { return _cursorY; }
+	int16_t fontHeight() const;
+	int16_t textWidth(const char *string) const;
+	int16_t textWidth(const String &string) const { return textWidth(string.c_str()); }
+	int16_t drawString(const char *string, int32_t x, int32_t y);
+	int16_t drawString(const String &string, int32_t x, int32_t y) { return drawString(string.c_str(), x, y); }
+	int16_t drawCentreString(const String &string, int32_t x, int32_t y, uint8_t font);
+
+	size_t write(uint8_t c) override;
+	using Print::write;
+
+	const uint16_t *frameBuffer() const { return _frame; }
+
+private:
+	void circleQuarter(int32_t x, int32_t y, int32_t r, uint8_t corners, uint32_t color);
+	void fillCircleHalf(int32_t x, int32_t y, int32_t r, uint8_t sides, int32_t stretch, uint32_t color);
+	int16_t drawGlyph(char c, int32_t x, int32_t baseline);
+
+	uint16_t _frame[TFT_WIDTH * TFT_HEIGHT];
+	int16_t _width, _height;
+	uint8_t _rotation = 0;
+	const GFXfont *_font = nullptr;
+	int16_t _glyphAbove = 0; // font ascent
+	int16_t _glyphBelow = 0; // font descent
+	uint16_t _textColor = TFT_WHITE;
+	uint16_t _textBgColor = TFT_BLACK;
+	uint8_t _datum = TL_DATUM;
+	uint8_t _textSize = 1;
+	int16_t _cursorX = 0, _cursorY = 0;
+};
+
+#endif // SIM_TFT_ESPI_H
+// End of file
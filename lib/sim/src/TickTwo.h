@@ -0,0 +1,68 @@
+/**
+ * @file TickTwo.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for the TickTwo timer library, v4.4.0 behaviour.
+ *
+ * @details Same constructor and semantics as the library: repeat 0 runs for
+ * ever, otherwise the timer stops after that many calls; the interval is
+ * in micros() unless resolution is MILLIS.
+ */
+
+#ifndef SIM_TICKTWO_H
+#define SIM_TICKTWO_H
+
+#include <Arduino.h>
+#include <functional>
+
+enum resolution_t
+{
+	MICROS,
+	MILLIS,
+	MICROS_MICROS
+};
+
+enum status_t
+{
+	STOPPED,
+	RUNNING,
+	PAUSED
+};
+
+typedef std::function<void(void)> fptr;
+
+class TickTwo
+{
+public:
+	TickTwo(fptr callback, uint32_t timer, uint32_t repeat = 0, resolution_t resolution = MICROS);
+
+	void start();
+	void resume();
+	void pause();
+	void stop();
+	void update();
+	void interval(uint32_t timer);
+
+	uint32_t interval() const { return _timer; }
+	uint32_t elapsed() const;
+	uint32_t remaining() const { return _timer - elapsed(); }
+	status_t state() const { return _status; }
+	uint32_t counter() const { return _counts; }
+
+private:
+	bool tick();
+	uint32_t now() const { return _resolution == MILLIS ? (uint32_t)millis() : (uint32_t)micros(); }
+
+	fptr _callback;
+	uint32_t _timer;
+	uint32_t _repeat;
+	resolution_t _resolution;
+	bool _enabled = false;
+	uint32_t _lastTime = 0;
+	uint32_t _diffTime = 0;
+	uint32_t _counts = 0;
+	status_t _status = STOPPED;
+};
+
+#endif // SIM_TICKTWO_H
+// End of file
@@ -0,0 +1,130 @@
+/**
+ * @file WString.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for the Arduino String class.
+ *
+ * @details Backed by std::string, so it allocates where the core's String
+ * does (short strings stay in the small-string buffer on both). Only the
+ * members the firmware and its tests use are provided.
+ */
+
+#ifndef SIM_WSTRING_H
+#define SIM_WSTRING_H
+
+#include <stddef.h>
+#include <stdlib.h> // strtol, strtof
+#include <string>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+class String
+{
+public:
+	String() {}
+	String(const char *cstr) : _s(cstr ? cstr : "") {}
+	String(const char *cstr, size_t length) : _s(cstr, length) {}
+	String(const __FlashStringHelper *str) : _s(reinterpret_cast<const char *>(str)) {}
+	explicit String(char c) : _s(1, c) {}
+	explicit String(unsigned char value, unsigned char base = 10) : String((unsigned long)value, base) {}
+	explicit String(int value, unsigned char base = 10) : String((long)value, base) {}
+	explicit String(unsigned int value, unsigned char base = 10) : String((unsigned long)value, base) {}
+	explicit String(long value, unsigned char base = 10);
+	explicit String(unsigned long value, unsigned char base = 10);
+	explicit String(float value, unsigned char decimals = 2) : String((double)value, decimals) {}
+	explicit String(double value, unsigned char decimals = 2);
+
+	unsigned int length() const { return (unsigned int)_s.length(); }
+	bool isEmpty() const { return _s.empty(); }
+	const char *c_str() const { return _s.c_str(); }
+	bool reserve(unsigned int size)
+	{
+		_s.reserve(size);
+		return true;
+	}
+
+	char charAt(unsigned int index) const { return index < _s.length() ? _s[index] : 0; }
+	char operator[](unsigned int index) const { return charAt(index); }
+	char &operator[](unsigned int index) { return _s[index]; }
+
+	bool concat(const String &str)
+	{
+		_s += str._s;
+		return true;
+	}
+	bool concat(const char *cstr)
+	{
+		_s += cstr ? cstr : "";
+		return true;
+	}
+	bool concat(const char *cstr, unsigned int length)
+	{
+		_s.append(cstr, length);
+		return true;
+	}
+	bool concat(char c)
+	{
+		_s += c;
+		return true;
+	}
+	bool concat(const __FlashStringHelper *str) { return concat(reinterpret_cast<const char *>(str)); }
+	bool concat(int value) { return concat(String(value)); }
+	bool concat(unsigned int value) { return concat(String(value)); }
+	bool concat(long value) { return concat(String(value)); }
+	bool concat(unsigned long value) { return concat(String(value)); }
+	bool concat(double value) { return concat(String(value)); }
+
+	template <typename T>
+	String &operator+=(const T &rhs)
+	{
+		concat(rhs);
+		return *this;
+	}
+
+	bool equals(const String &s) const { return _s == s._s; }
+	bool equals(const char *cstr) const { return _s == (cstr ? cstr : ""); }
+	bool operator==(const String &rhs) const { return equals(rhs); }
+	bool operator==(const char *cstr) const { return equals(cstr); }
+	bool operator!=(const String &rhs) const { return !equals(rhs); }
+	bool operator!=(const char *cstr) const { return !equals(cstr); }
+	bool operator<(const String &rhs) const { return _s < rhs._s; }
+	bool equalsIgnoreCase(const String &s) const;
+	bool startsWith(const String &prefix) const { return _s.compare(0, prefix._s.length(), prefix._s) == 0; }
+	bool endsWith(const String &suffix) const;
+
+	int indexOf(char c, unsigned int from = 0) const;
+	int indexOf(const String &str, unsigned int from = 0) const;
+	int lastIndexOf(char c) const;
+	String substring(unsigned int from) const { return substring(from, length()); }
+	String substring(unsigned int from, unsigned int to) const;
+
+	void replace(const String &find, const String &replacement);
+	void remove(unsigned int index) { remove(index, length()); }
+	void remove(unsigned int index, unsigned int count);
+	void toLowerCase();
+	void toUpperCase();
+	void trim();
+
+	long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+	float toFloat() const { return strtof(_s.c_str(), nullptr); }
+	void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const;
+
+private:
+	std::string _s;
+};
+
+// concatenation, as the core's StringSumHelper allows
+String operator+(const String &lhs, const String &rhs);
+String operator+(const String &lhs, const char *rhs);
+String operator+(const char *lhs, const String &rhs);
+String operator+(const String &lhs, char rhs);
+String operator+(const String &lhs, int rhs);
+String operator+(const String &lhs, unsigned int rhs);
+String operator+(const String &lhs, long rhs);
+String operator+(const String &lhs, unsigned long rhs);
+String operator+(const String &lhs, double rhs);
+String operator+(const String &lhs, const __FlashStringHelper *rhs);
+
+#endif // SIM_WSTRING_H
+// End of file
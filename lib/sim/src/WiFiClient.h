@@ -0,0 +1,55 @@
+/**
+ * @file WiFiClient.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for the ESP8266 WiFiClient, over a POSIX TCP socket.
+ *
+ * @details connect() blocks for at most the Stream timeout, as on the device;
+ * after that the socket is non-blocking. availableForWrite() reports the room
+ * left in a send buffer the size of the ESP8266 lwIP one (two 1460-byte
+ * segments), so transmit backpressure looks as it does on the device.
+ * A --aprs HOST:PORT option sends every connection to that address instead;
+ * --aprs-map HOST=PORT sends connections to one host to a local port.
+ */
+
+#ifndef SIM_WIFI_CLIENT_H
+#define SIM_WIFI_CLIENT_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+
+const int SIM_TCP_SND_BUF = 2 * 1460; // ESP8266 lwIP send buffer
+
+class WiFiClient : public Stream
+{
+public:
+	WiFiClient() {}
+	~WiFiClient() override { stop(); }
+	WiFiClient(const WiFiClient &) = delete;
+	WiFiClient &operator=(const WiFiClient &) = delete;
+
+	int connect(const char *host, uint16_t port);
+	int connect(const String &host, uint16_t port) { return connect(host.c_str(), port); }
+	uint8_t connected();
+	void stop();
+	explicit operator bool() { return connected(); }
+
+	int available() override;
+	int read() override;
+	int read(uint8_t *buf, size_t size);
+	int peek() override;
+
+	int availableForWrite() override;
+	size_t write(uint8_t c) override { return write(&c, 1); }
+	size_t write(const uint8_t *buf, size_t size) override;
+	using Print::write;
+	void flush() override {}
+
+	void setNoDelay(bool noDelay);
+
+private:
+	int _fd = -1;
+};
+
+#endif // SIM_WIFI_CLIENT_H
+// End of file
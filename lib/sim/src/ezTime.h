@@ -0,0 +1,77 @@
+/**
+ * @file ezTime.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Host stand-in for the ezTime library on the simulator clock.
+ *
+ * @details There is no NTP: waitForSync() returns at once and UTC is the
+ * simulator's settable clock. Every Timezone except UTC uses the fixed
+ * --utc-offset; daylight saving time is not modelled. Events set with
+ * setEvent() run from events() as in ezTime.
+ */
+
+#ifndef SIM_EZTIME_H
+#define SIM_EZTIME_H
+
+#include <Arduino.h>
+#include <time.h>
+
+#define TIME_NOW ((time_t)0x7FFFFFFF)
+#define MAX_EVENTS 8
+
+enum timeStatus_t
+{
+	timeNotSet,
+	timeNeedsSync,
+	timeSet
+};
+
+enum ezLocalOrUTC_t
+{
+	UTC_TIME = 1,
+	LOCAL_TIME = 2
+};
+
+class Timezone
+{
+public:
+	explicit Timezone(bool lockedToUTC = false) : _lockedToUTC(lockedToUTC) {}
+
+	bool setLocation(const String &location = "GeoIP");
+	String getOlson() const { return _olson; }
+	bool setPosix(const String &posix);
+	bool setCache(int16_t address);
+	void setDefault();
+	int16_t getOffset() const; // minutes west of UTC, as ezTime reports it
+
+	time_t now() const;
+	uint8_t hour(time_t t = TIME_NOW, ezLocalOrUTC_t localOrUTC = LOCAL_TIME) const;
+	uint8_t minute(time_t t = TIME_NOW, ezLocalOrUTC_t localOrUTC = LOCAL_TIME) const;
+	uint8_t second(time_t t = TIME_NOW, ezLocalOrUTC_t localOrUTC = LOCAL_TIME) const;
+	uint8_t day(time_t t = TIME_NOW, ezLocalOrUTC_t localOrUTC = LOCAL_TIME) const;
+	uint8_t weekday(time_t t = TIME_NOW, ezLocalOrUTC_t localOrUTC = LOCAL_TIME) const; // 1 = Sunday
+	uint8_t month(time_t t = TIME_NOW, ezLocalOrUTC_t localOrUTC = LOCAL_TIME) const;
+	uint16_t year(time_t t = TIME_NOW, ezLocalOrUTC_t localOrUTC = LOCAL_TIME) const;
+
+	time_t tzTime(time_t t, ezLocalOrUTC_t localOrUTC = LOCAL_TIME) const; // local <-> UTC
+	uint8_t setEvent(void (*function)(), time_t t = TIME_NOW, ezLocalOrUTC_t localOrUTC = LOCAL_TIME);
+
+private:
+	struct tm fields(time_t t, ezLocalOrUTC_t localOrUTC) const;
+
+	bool _lockedToUTC;
+	String _olson;
+};
+
+extern Timezone UTC;
+extern Timezone *defaultTZ;
+
+bool waitForSync(uint16_t timeout = 0);
+timeStatus_t timeStatus();
+void events();
+void deleteEvent(uint8_t eventHandle);
+void deleteEvent(void (*function)());
+time_t makeTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t day, uint8_t month, uint16_t year);
+
+#endif // SIM_EZTIME_H
+// End of file
@@ -0,0 +1,72 @@
+/**
+ * @file sim.h
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Controls for running the firmware as a Linux process.
+ *
+ * @details The simulator calls setup() once and loop() until the run ends.
+ * Its clock is the host's monotonic clock plus any virtual time added by
+ * simAdvance(): in real-time mode nothing is added and delay() sleeps; in fast
+ * mode delay() and every loop() pass add virtual time instead, so days of
+ * firmware time pass in seconds while micros() still measures real code.
+ *
+ * Command line (all optional):
+ *
+ *     --fast              run on virtual time
+ *     --step-us N         virtual time per loop() pass in fast mode (1000)
+ *     --duration S        stop after S seconds of firmware time
+ *     --fs DIR            directory that stands in for LittleFS (data)
+ *     --epoch T           UTC time at start, seconds since 1970 (host time)
+ *     --utc-offset MIN    local time offset for every Timezone but UTC (0)
+ *     --aprs HOST:PORT    connect every WiFiClient here instead
+ *     --aprs-map HOST=PORT  connect to HOST on 127.0.0.1:PORT instead, before
+ *                         --aprs; repeat for each server in the firmware's list
+ *     --screen FILE.ppm   write the display framebuffer on exit
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <time.h>
+
+const int SIM_MAX_ENDPOINT_MAPS = 8; // --aprs-map options kept
+
+//! One --aprs-map option
+struct SimEndpointMap
+{
+	const char *host; // host name the firmware connects to
+	uint16_t port;	  // local port used instead
+};
+
+struct SimOptions
+{
+	bool fast = false;				  // virtual time instead of the wall clock
+	uint32_t stepUs = 1000;			  // virtual time per loop() pass when fast
+	uint64_t durationUs = 0;		  // 0 runs until interrupted
+	const char *fsRoot = "data";	  // LittleFS root directory
+	int64_t epoch = -1;				  // UTC at start, -1 for the host time
+	int utcOffsetMinutes = 0;		  // local time offset
+	const char *redirectHost = nullptr; // WiFiClient target override
+	uint16_t redirectPort = 0;
+	SimEndpointMap endpointMaps[SIM_MAX_ENDPOINT_MAPS]; // per-host overrides, checked first
+	int endpointMapCount = 0;
+	const char *screenFile = nullptr; // framebuffer dump on exit
+};
+
+extern SimOptions simOptions;
+
+bool simParseArgs(int argc, char **argv);
+
+// clock
+uint64_t simMicros();		  // firmware time since start
+void simAdvance(uint64_t us); // add virtual time
+void simSleep(uint64_t us);	  // delay(): sleep when real time, advance when fast
+time_t simUTC();			  // current UTC
+void simSetUTC(time_t utc);	  // set the UTC clock, e.g. from a test
+
+// display
+bool simWriteScreen(const char *path);
+
+#endif // SIM_H
+// End of file
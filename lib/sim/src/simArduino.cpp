@@ -0,0 +1,480 @@
+/**
+ * @file simArduino.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the host Arduino core: String, Print, Stream,
+ * Serial, time, random numbers and pins.
+ *
+ * Serial goes to stdout. random() is a small seeded generator, so a run with
+ * the same seed sees the same sequence; ESP.random() is not seeded, like the
+ * hardware generator it stands in for. RTC user memory lasts for the run.
+ */
+
+#include <Arduino.h>
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <random>
+#include "sim.h"
+
+HardwareSerial Serial;
+
+// ******************* String **************************
+
+static std::string formatUnsigned(unsigned long value, unsigned char base)
+{
+	if (base < 2 || base > 36)
+	{
+		base = 10;
+	}
+	char buf[8 * sizeof(value) + 1];
+	char *p = buf + sizeof(buf);
+	*--p = '\0';
+	do
+	{
+		int digit = value % base;
+		*--p = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+		value /= base;
+	} while (value > 0);
+	return p;
+}
+
+String::String(long value, unsigned char base)
+{
+	if (value < 0 && base == 10)
+	{
+		_s = "-" + formatUnsigned(0UL - (unsigned long)value, base);
+	}
+	else
+	{
+		_s = formatUnsigned((unsigned long)value, base);
+	}
+}
+
+String::String(unsigned long value, unsigned char base) : _s(formatUnsigned(value, base)) {}
+
+String::String(double value, unsigned char decimals)
+{
+	char buf[64];
+	snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+	_s = buf;
+}
+
+bool String::equalsIgnoreCase(const String &s) const
+{
+	return strcasecmp(_s.c_str(), s._s.c_str()) == 0;
+}
+
+bool String::endsWith(const String &suffix) const
+{
+	return _s.length() >= suffix._s.length() &&
+		   _s.compare(_s.length() - suffix._s.length(), suffix._s.length(), suffix._s) == 0;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+	size_t pos = _s.find(c, from);
+	return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String &str, unsigned int from) const
+{
+	size_t pos = _s.find(str._s, from);
+	return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const
+{
+	size_t pos = _s.rfind(c);
+	return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+	if (from > to)
+	{
+		unsigned int t = from;
+		from = to;
+		to = t;
+	}
+	if (from >= _s.length())
+	{
+		return String();
+	}
+	if (to > _s.length())
+	{
+		to = _s.length();
+	}
+	return String(_s.c_str() + from, to - from);
+}
+
+void String::replace(const String &find, const String &replacement)
+{
+	if (find._s.empty())
+	{
+		return;
+	}
+	size_t pos = 0;
+	while ((pos = _s.find(find._s, pos)) != std::string::npos)
+	{
+		_s.replace(pos, find._s.length(), replacement._s);
+		pos += replacement._s.length();
+	}
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+	if (index < _s.length())
+	{
+		_s.erase(index, count);
+	}
+}
+
+void String::toLowerCase()
+{
+	for (char &c : _s)
+	{
+		c = (char)tolower((unsigned char)c);
+	}
+}
+
+void String::toUpperCase()
+{
+	for (char &c : _s)
+	{
+		c = (char)toupper((unsigned char)c);
+	}
+}
+
+void String::trim()
+{
+	size_t begin = 0;
+	size_t end = _s.length();
+	while (begin < end && isspace((unsigned char)_s[begin]))
+	{
+		begin++;
+	}
+	while (end > begin && isspace((unsigned char)_s[end - 1]))
+	{
+		end--;
+	}
+	_s = _s.substr(begin, end - begin);
+}
+
+void String::toCharArray(char *buf, unsigned int bufsize, unsigned int index) const
+{
+	if (bufsize == 0 || buf == nullptr)
+	{
+		return;
+	}
+	size_t n = 0;
+	if (index < _s.length())
+	{
+		n = std::min((size_t)bufsize - 1, _s.length() - index);
+		memcpy(buf, _s.c_str() + index, n);
+	}
+	buf[n] = '\0';
+}
+
+String operator+(const String &lhs, const String &rhs)
+{
+	String s(lhs);
+	s.concat(rhs);
+	return s;
+}
+
+String operator+(const String &lhs, const char *rhs)
+{
+	String s(lhs);
+	s.concat(rhs);
+	return s;
+}
+
+String operator+(const char *lhs, const String &rhs)
+{
+	String s(lhs);
+	s.concat(rhs);
+	return s;
+}
+
+String operator+(const String &lhs, char rhs)
+{
+	String s(lhs);
+	s.concat(rhs);
+	return s;
+}
+
+String operator+(const String &lhs, int rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, unsigned int rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, long rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, unsigned long rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, double rhs) { return lhs + String(rhs); }
+String operator+(const String &lhs, const __FlashStringHelper *rhs) { return lhs + String(rhs); }
+
+// ******************* Print ***************************
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+	size_t n = 0;
+	while (size--)
+	{
+		if (write(*buffer++) == 0)
+		{
+			break;
+		}
+		n++;
+	}
+	return n;
+}
+
+size_t Print::print(long value, int base)
+{
+	return print(String(value, (unsigned char)base));
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+	return print(String(value, (unsigned char)base));
+}
+
+size_t Print::print(double value, int digits)
+{
+	return print(String(value, (unsigned char)digits));
+}
+
+size_t Print::printf(const char *format, ...)
+{
+	char buf[256];
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(buf, sizeof(buf), format, args);
+	va_end(args);
+	if (length < 0)
+	{
+		return 0;
+	}
+	if ((size_t)length < sizeof(buf))
+	{
+		return write(buf, length);
+	}
+
+	std::string big(length + 1, '\0');
+	va_start(args, format);
+	vsnprintf(&big[0], big.size(), format, args);
+	va_end(args);
+	return write(big.c_str(), length);
+}
+
+// ******************* Stream **************************
+
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+	size_t n = 0;
+	while (n < length)
+	{
+		int c = read();
+		if (c < 0)
+		{
+			break;
+		}
+		buffer[n++] = (char)c;
+	}
+	return n;
+}
+
+size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length)
+{
+	size_t n = 0;
+	while (n < length)
+	{
+		int c = read();
+		if (c < 0 || c == terminator)
+		{
+			break;
+		}
+		buffer[n++] = (char)c;
+	}
+	return n;
+}
+
+String Stream::readString()
+{
+	String s;
+	int c;
+	while ((c = read()) >= 0)
+	{
+		s.concat((char)c);
+	}
+	return s;
+}
+
+String Stream::readStringUntil(char terminator)
+{
+	String s;
+	int c;
+	while ((c = read()) >= 0 && c != terminator)
+	{
+		s.concat((char)c);
+	}
+	return s;
+}
+
+// ******************* Serial **************************
+
+void HardwareSerial::begin(unsigned long baud)
+{
+	(void)baud;
+	setvbuf(stdout, nullptr, _IOLBF, 0);
+}
+
+void HardwareSerial::flush()
+{
+	fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+	if (c == '\r')
+	{
+		return 1; // println() ends lines with CR LF
+	}
+	return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		write(buffer[i]);
+	}
+	return size;
+}
+
+// ******************* Time ****************************
+
+unsigned long millis()
+{
+	return (unsigned long)(simMicros() / 1000);
+}
+
+unsigned long micros()
+{
+	return (unsigned long)simMicros();
+}
+
+void delay(unsigned long ms)
+{
+	simSleep((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+	simSleep(us);
+}
+
+void yield() {}
+
+// ******************* Random **************************
+
+static uint32_t randomState = 1;
+
+//! Park-Miller minimal standard generator.
+static long nextRandom()
+{
+	randomState = (uint32_t)(((uint64_t)randomState * 48271UL) % 2147483647UL);
+	return (long)randomState;
+}
+
+void randomSeed(unsigned long seed)
+{
+	if (seed != 0)
+	{
+		randomState = (uint32_t)(seed % 2147483647UL);
+		if (randomState == 0)
+		{
+			randomState = 1;
+		}
+	}
+}
+
+long random(long howBig)
+{
+	if (howBig <= 0)
+	{
+		return 0;
+	}
+	return nextRandom() % howBig;
+}
+
+long random(long howSmall, long howBig)
+{
+	if (howSmall >= howBig)
+	{
+		return howSmall;
+	}
+	return random(howBig - howSmall) + howSmall;
+}
+
+EspClass ESP;
+
+//! The host's entropy source, unseeded like the device's RNG.
+uint32_t EspClass::random()
+{
+	static std::random_device device;
+	return (uint32_t)device();
+}
+
+// 512 bytes of RTC user memory, cleared at the start of each run as by a power-up
+static uint32_t rtcUserMemory[128];
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size)
+{
+	if (offset * 4 + size > sizeof(rtcUserMemory) || size % 4 != 0)
+	{
+		return false;
+	}
+	memcpy(data, rtcUserMemory + offset, size);
+	return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size)
+{
+	if (offset * 4 + size > sizeof(rtcUserMemory) || size % 4 != 0)
+	{
+		return false;
+	}
+	memcpy(rtcUserMemory + offset, data, size);
+	return true;
+}
+
+// ******************* Pins ****************************
+
+static uint8_t pinLevels[32];
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+	(void)pin;
+	(void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+	if (pin < sizeof(pinLevels))
+	{
+		pinLevels[pin] = value ? HIGH : LOW;
+	}
+}
+
+int digitalRead(uint8_t pin)
+{
+	return pin < sizeof(pinLevels) ? pinLevels[pin] : LOW;
+}
+
+//! A floating pin: a few counts of noise around mid-scale.
+int analogRead(uint8_t pin)
+{
+	(void)pin;
+	return 512 + (int)(simMicros() % 7) - 3;
+}
+
+// End of file
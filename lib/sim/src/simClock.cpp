@@ -0,0 +1,64 @@
+/**
+ * @file simClock.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Simulator clock behind millis(), micros(), delay() and ezTime.
+ *
+ * Firmware time is host monotonic time since start plus the virtual time
+ * added so far. The UTC clock is an offset from firmware time, so setting it
+ * does not disturb millis().
+ */
+
+#include "sim.h"
+
+#include <chrono>
+#include <thread>
+
+static const std::chrono::steady_clock::time_point simStart = std::chrono::steady_clock::now();
+static uint64_t simVirtualUs = 0; // virtual time added by simAdvance()
+static bool utcSet = false;
+static int64_t utcAtZero = 0; // UTC when firmware time was 0
+
+//! Firmware time in microseconds since start.
+uint64_t simMicros()
+{
+	using namespace std::chrono;
+	return (uint64_t)duration_cast<microseconds>(steady_clock::now() - simStart).count() + simVirtualUs;
+}
+
+//! Moves firmware time forward without waiting.
+void simAdvance(uint64_t us)
+{
+	simVirtualUs += us;
+}
+
+//! Waits for us of firmware time.
+void simSleep(uint64_t us)
+{
+	if (simOptions.fast)
+	{
+		simAdvance(us);
+	}
+	else
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(us));
+	}
+}
+
+//! Current UTC, from --epoch or the host clock at start.
+time_t simUTC()
+{
+	if (!utcSet)
+	{
+		simSetUTC(simOptions.epoch >= 0 ? (time_t)simOptions.epoch : time(nullptr));
+	}
+	return (time_t)(utcAtZero + (int64_t)(simMicros() / 1000000));
+}
+
+void simSetUTC(time_t utc)
+{
+	utcAtZero = (int64_t)utc - (int64_t)(simMicros() / 1000000);
+	utcSet = true;
+}
+
+// End of file
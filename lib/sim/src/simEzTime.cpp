@@ -0,0 +1,173 @@
+/**
+ * @file simEzTime.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the host ezTime stand-in.
+ *
+ * Local times are UTC shifted by the fixed offset and broken down with
+ * gmtime_r(), so the host's own time zone never leaks in. Event times are
+ * kept in UTC.
+ */
+
+#include <ezTime.h>
+
+#include "sim.h"
+
+Timezone UTC(true);
+Timezone *defaultTZ = &UTC;
+
+struct SimEvent
+{
+	void (*function)();
+	time_t utc;
+};
+static SimEvent eventTable[MAX_EVENTS];
+
+// ******************* Timezone ************************
+
+bool Timezone::setLocation(const String &location)
+{
+	_olson = location;
+	return true;
+}
+
+bool Timezone::setPosix(const String &posix)
+{
+	(void)posix;
+	return true; // --utc-offset applies regardless
+}
+
+bool Timezone::setCache(int16_t address)
+{
+	(void)address;
+	return false; // no EEPROM cache, as on a fresh device
+}
+
+void Timezone::setDefault()
+{
+	defaultTZ = this;
+}
+
+int16_t Timezone::getOffset() const
+{
+	return _lockedToUTC ? 0 : (int16_t)-simOptions.utcOffsetMinutes;
+}
+
+time_t Timezone::now() const
+{
+	return simUTC() - (time_t)getOffset() * 60;
+}
+
+time_t Timezone::tzTime(time_t t, ezLocalOrUTC_t localOrUTC) const
+{
+	if (t == TIME_NOW)
+	{
+		return localOrUTC == LOCAL_TIME ? now() : simUTC();
+	}
+	// LOCAL_TIME: t is local, give UTC; UTC_TIME: t is UTC, give local
+	return localOrUTC == LOCAL_TIME ? t + (time_t)getOffset() * 60 : t - (time_t)getOffset() * 60;
+}
+
+struct tm Timezone::fields(time_t t, ezLocalOrUTC_t localOrUTC) const
+{
+	if (t == TIME_NOW)
+	{
+		t = now();
+	}
+	else if (localOrUTC == UTC_TIME)
+	{
+		t = tzTime(t, UTC_TIME);
+	}
+	struct tm out;
+	gmtime_r(&t, &out);
+	return out;
+}
+
+uint8_t Timezone::hour(time_t t, ezLocalOrUTC_t localOrUTC) const { return fields(t, localOrUTC).tm_hour; }
+uint8_t Timezone::minute(time_t t, ezLocalOrUTC_t localOrUTC) const { return fields(t, localOrUTC).tm_min; }
+uint8_t Timezone::second(time_t t, ezLocalOrUTC_t localOrUTC) const { return fields(t, localOrUTC).tm_sec; }
+uint8_t Timezone::day(time_t t, ezLocalOrUTC_t localOrUTC) const { return fields(t, localOrUTC).tm_mday; }
+uint8_t Timezone::weekday(time_t t, ezLocalOrUTC_t localOrUTC) const { return fields(t, localOrUTC).tm_wday + 1; }
+uint8_t Timezone::month(time_t t, ezLocalOrUTC_t localOrUTC) const { return fields(t, localOrUTC).tm_mon + 1; }
+uint16_t Timezone::year(time_t t, ezLocalOrUTC_t localOrUTC) const { return fields(t, localOrUTC).tm_year + 1900; }
+
+/**
+ * @brief Schedules function to run from events() at time t.
+ *
+ * @return Event handle, 0 if the table is full.
+ */
+uint8_t Timezone::setEvent(void (*function)(), time_t t, ezLocalOrUTC_t localOrUTC)
+{
+	time_t utc = (t == TIME_NOW) ? simUTC() : (localOrUTC == LOCAL_TIME ? tzTime(t, LOCAL_TIME) : t);
+	for (uint8_t i = 0; i < MAX_EVENTS; i++)
+	{
+		if (eventTable[i].function == nullptr)
+		{
+			eventTable[i].function = function;
+			eventTable[i].utc = utc;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+// ******************* Free functions ******************
+
+bool waitForSync(uint16_t timeout)
+{
+	(void)timeout;
+	return true;
+}
+
+timeStatus_t timeStatus()
+{
+	return timeSet;
+}
+
+//! Runs the events that are due, each once.
+void events()
+{
+	time_t utc = simUTC();
+	for (uint8_t i = 0; i < MAX_EVENTS; i++)
+	{
+		if (eventTable[i].function != nullptr && eventTable[i].utc <= utc)
+		{
+			void (*function)() = eventTable[i].function;
+			eventTable[i].function = nullptr;
+			function();
+		}
+	}
+}
+
+void deleteEvent(uint8_t eventHandle)
+{
+	if (eventHandle > 0 && eventHandle <= MAX_EVENTS)
+	{
+		eventTable[eventHandle - 1].function = nullptr;
+	}
+}
+
+void deleteEvent(void (*function)())
+{
+	for (uint8_t i = 0; i < MAX_EVENTS; i++)
+	{
+		if (eventTable[i].function == function)
+		{
+			eventTable[i].function = nullptr;
+		}
+	}
+}
+
+time_t makeTime(uint8_t hour, uint8_t minute, uint8_t second, uint8_t day, uint8_t month, uint16_t year)
+{
+	struct tm fields = {};
+	fields.tm_hour = hour;
+	fields.tm_min = minute;
+	fields.tm_sec = second;
+	fields.tm_mday = day;
+	fields.tm_mon = month - 1;
+	fields.tm_year = year - 1900;
+	return timegm(&fields);
+}
+
+// End of file
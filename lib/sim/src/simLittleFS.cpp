@@ -0,0 +1,192 @@
+/**
+ * @file simLittleFS.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the host file system over a directory.
+ *
+ * Modes follow LittleFS: "r", "w", "a" and their "+" forms. Paths are
+ * absolute LittleFS paths; the leading '/' is joined to the --fs directory.
+ */
+
+#include <LittleFS.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include "sim.h"
+
+fs::FS LittleFS;
+
+namespace fs
+{
+
+// ******************* File ****************************
+
+File::File(FILE *file, const String &name) : _file(file, fclose), _name(name) {}
+
+//! Bytes from the position to the end of the file.
+int File::available()
+{
+	if (!_file)
+	{
+		return 0;
+	}
+	size_t pos = position();
+	size_t end = size();
+	return end > pos ? (int)(end - pos) : 0;
+}
+
+int File::read()
+{
+	return _file ? fgetc(_file.get()) : -1;
+}
+
+int File::peek()
+{
+	if (!_file)
+	{
+		return -1;
+	}
+	int c = fgetc(_file.get());
+	if (c != EOF)
+	{
+		ungetc(c, _file.get());
+	}
+	return c;
+}
+
+int File::read(uint8_t *buf, size_t size)
+{
+	return _file ? (int)fread(buf, 1, size, _file.get()) : -1;
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+	return _file ? fwrite(buf, 1, size, _file.get()) : 0;
+}
+
+void File::flush()
+{
+	if (_file)
+	{
+		fflush(_file.get());
+	}
+}
+
+bool File::seek(uint32_t pos, SeekMode mode)
+{
+	static const int whence[] = {SEEK_SET, SEEK_CUR, SEEK_END};
+	return _file && fseek(_file.get(), (long)pos, whence[mode]) == 0;
+}
+
+size_t File::position() const
+{
+	if (!_file)
+	{
+		return 0;
+	}
+	long pos = ftell(_file.get());
+	return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const
+{
+	if (!_file)
+	{
+		return 0;
+	}
+	fflush(_file.get());
+	struct stat st;
+	return fstat(fileno(_file.get()), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close()
+{
+	_file.reset();
+}
+
+// ******************* FS ******************************
+
+String FS::hostPath(const char *path) const
+{
+	String full(simOptions.fsRoot);
+	if (path[0] != '/')
+	{
+		full += '/';
+	}
+	full += path;
+	return full;
+}
+
+//! Mounts the directory, creating it if needed.
+bool FS::begin()
+{
+	struct stat st;
+	if (stat(simOptions.fsRoot, &st) == 0)
+	{
+		return S_ISDIR(st.st_mode);
+	}
+	return ::mkdir(simOptions.fsRoot, 0755) == 0;
+}
+
+bool FS::format()
+{
+	return false; // never wipe a host directory
+}
+
+bool FS::info(FSInfo &info)
+{
+	struct statvfs vfs;
+	if (statvfs(simOptions.fsRoot, &vfs) != 0)
+	{
+		return false;
+	}
+	info.blockSize = vfs.f_bsize;
+	info.pageSize = 256;
+	info.totalBytes = (size_t)vfs.f_blocks * vfs.f_frsize;
+	info.usedBytes = (size_t)(vfs.f_blocks - vfs.f_bfree) * vfs.f_frsize;
+	info.maxOpenFiles = 5;
+	info.maxPathLength = 32;
+	return true;
+}
+
+File FS::open(const char *path, const char *mode)
+{
+	char hostMode[4] = {mode[0], 'b', '\0', '\0'};
+	if (mode[1] == '+')
+	{
+		hostMode[2] = '+';
+	}
+	FILE *file = fopen(hostPath(path).c_str(), hostMode);
+	if (file == nullptr)
+	{
+		return File();
+	}
+	return File(file, path);
+}
+
+bool FS::exists(const char *path)
+{
+	struct stat st;
+	return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path)
+{
+	return ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *from, const char *to)
+{
+	return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path)
+{
+	return ::mkdir(hostPath(path).c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+} // namespace fs
+
+// End of file
@@ -0,0 +1,141 @@
+/**
+ * @file simMain.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Entry point that runs the firmware's setup() and loop() on the host.
+ *
+ * The run ends after --duration of firmware time or on Ctrl-C; the display is
+ * then saved if --screen was given. Test suites provide their own main().
+ */
+
+#include <Arduino.h>
+
+#include <signal.h>
+#include "sim.h"
+
+SimOptions simOptions;
+
+/**
+ * @brief Reads the command line into simOptions.
+ *
+ * @return false on an unknown or incomplete option.
+ */
+bool simParseArgs(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+		if (strcmp(arg, "--fast") == 0)
+		{
+			simOptions.fast = true;
+			continue;
+		}
+		if (value == nullptr)
+		{
+			return false;
+		}
+		i++;
+		if (strcmp(arg, "--step-us") == 0)
+		{
+			simOptions.stepUs = (uint32_t)strtoul(value, nullptr, 10);
+		}
+		else if (strcmp(arg, "--duration") == 0)
+		{
+			simOptions.durationUs = (uint64_t)(strtod(value, nullptr) * 1e6);
+		}
+		else if (strcmp(arg, "--fs") == 0)
+		{
+			simOptions.fsRoot = value;
+		}
+		else if (strcmp(arg, "--epoch") == 0)
+		{
+			simOptions.epoch = strtoll(value, nullptr, 10);
+		}
+		else if (strcmp(arg, "--utc-offset") == 0)
+		{
+			simOptions.utcOffsetMinutes = atoi(value);
+		}
+		else if (strcmp(arg, "--aprs") == 0)
+		{
+			char *colon = strrchr(argv[i], ':');
+			if (colon == nullptr)
+			{
+				return false;
+			}
+			*colon = '\0';
+			simOptions.redirectHost = value;
+			simOptions.redirectPort = (uint16_t)atoi(colon + 1);
+		}
+		else if (strcmp(arg, "--aprs-map") == 0)
+		{
+			char *equals = strrchr(argv[i], '=');
+			if (equals == nullptr || simOptions.endpointMapCount == SIM_MAX_ENDPOINT_MAPS)
+			{
+				return false;
+			}
+			*equals = '\0';
+			SimEndpointMap &map = simOptions.endpointMaps[simOptions.endpointMapCount++];
+			map.host = value;
+			map.port = (uint16_t)atoi(equals + 1);
+		}
+		else if (strcmp(arg, "--screen") == 0)
+		{
+			simOptions.screenFile = value;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+#ifndef PIO_UNIT_TESTING
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int)
+{
+	stopRequested = 1;
+}
+
+static void usage(const char *program)
+{
+	fprintf(stderr,
+			"usage: %s [--fast] [--step-us N] [--duration S] [--fs DIR] [--epoch T]\n"
+			"          [--utc-offset MIN] [--aprs HOST:PORT] [--aprs-map HOST=PORT]...\n"
+			"          [--screen FILE.ppm]\n",
+			program);
+}
+
+int main(int argc, char **argv)
+{
+	if (!simParseArgs(argc, argv))
+	{
+		usage(argv[0]);
+		return 2;
+	}
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+
+	setup();
+	while (!stopRequested && (simOptions.durationUs == 0 || simMicros() < simOptions.durationUs))
+	{
+		loop();
+		if (simOptions.fast)
+		{
+			simAdvance(simOptions.stepUs);
+		}
+	}
+
+	fflush(stdout);
+	if (simOptions.screenFile != nullptr && !simWriteScreen(simOptions.screenFile))
+	{
+		fprintf(stderr, "cannot write %s\n", simOptions.screenFile);
+		return 1;
+	}
+	return 0;
+}
+#endif // PIO_UNIT_TESTING
+
+// End of file
@@ -0,0 +1,401 @@
+/**
+ * @file simTFT.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the framebuffer TFT_eSPI.
+ *
+ * Shapes follow the Adafruit GFX algorithms TFT_eSPI is built on, so the
+ * screen matches the panel pixel for pixel closely enough to check layouts.
+ * The framebuffer is kept in the rotated coordinates the firmware draws in.
+ */
+
+#include <TFT_eSPI.h>
+
+#include "sim.h"
+
+static TFT_eSPI *screen = nullptr; // display saved by simWriteScreen()
+
+TFT_eSPI::TFT_eSPI(int16_t width, int16_t height) : _width(width), _height(height)
+{
+	memset(_frame, 0, sizeof(_frame));
+	screen = this;
+}
+
+void TFT_eSPI::init()
+{
+	fillScreen(TFT_BLACK);
+}
+
+void TFT_eSPI::setRotation(uint8_t rotation)
+{
+	_rotation = rotation % 4;
+	_width = (_rotation & 1) ? TFT_HEIGHT : TFT_WIDTH;
+	_height = (_rotation & 1) ? TFT_WIDTH : TFT_HEIGHT;
+}
+
+// ******************* Shapes **************************
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
+{
+	if (x >= 0 && y >= 0 && x < _width && y < _height)
+	{
+		_frame[y * _width + x] = (uint16_t)color;
+	}
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) const
+{
+	if (x < 0 || y < 0 || x >= _width || y >= _height)
+	{
+		return 0;
+	}
+	return _frame[y * _width + x];
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+	int32_t x1 = std::min<int32_t>(x + w, _width);
+	int32_t y1 = std::min<int32_t>(y + h, _height);
+	for (int32_t row = std::max<int32_t>(y, 0); row < y1; row++)
+	{
+		for (int32_t col = std::max<int32_t>(x, 0); col < x1; col++)
+		{
+			_frame[row * _width + col] = (uint16_t)color;
+		}
+	}
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+	drawFastHLine(x, y, w, color);
+	drawFastHLine(x, y + h - 1, w, color);
+	drawFastVLine(x, y, h, color);
+	drawFastVLine(x + w - 1, y, h, color);
+}
+
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color)
+{
+	int32_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+	int32_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+	int32_t err = dx + dy;
+	for (;;)
+	{
+		drawPixel(x0, y0, color);
+		if (x0 == x1 && y0 == y1)
+		{
+			break;
+		}
+		int32_t e2 = 2 * err;
+		if (e2 >= dy)
+		{
+			err += dy;
+			x0 += sx;
+		}
+		if (e2 <= dx)
+		{
+			err += dx;
+			y0 += sy;
+		}
+	}
+}
+
+//! Draws the selected quarters of a circle outline: 1 TL, 2 TR, 4 BR, 8 BL.
+void TFT_eSPI::circleQuarter(int32_t x0, int32_t y0, int32_t r, uint8_t corners, uint32_t color)
+{
+	int32_t f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+	while (x < y)
+	{
+		if (f >= 0)
+		{
+			y--;
+			ddy += 2;
+			f += ddy;
+		}
+		x++;
+		ddx += 2;
+		f += ddx;
+		if (corners & 0x4)
+		{
+			drawPixel(x0 + x, y0 + y, color);
+			drawPixel(x0 + y, y0 + x, color);
+		}
+		if (corners & 0x2)
+		{
+			drawPixel(x0 + x, y0 - y, color);
+			drawPixel(x0 + y, y0 - x, color);
+		}
+		if (corners & 0x8)
+		{
+			drawPixel(x0 - y, y0 + x, color);
+			drawPixel(x0 - x, y0 + y, color);
+		}
+		if (corners & 0x1)
+		{
+			drawPixel(x0 - y, y0 - x, color);
+			drawPixel(x0 - x, y0 - y, color);
+		}
+	}
+}
+
+//! Fills the right (1) and/or left (2) half of a circle, stretched vertically.
+void TFT_eSPI::fillCircleHalf(int32_t x0, int32_t y0, int32_t r, uint8_t sides, int32_t stretch, uint32_t color)
+{
+	int32_t f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+	while (x < y)
+	{
+		if (f >= 0)
+		{
+			y--;
+			ddy += 2;
+			f += ddy;
+		}
+		x++;
+		ddx += 2;
+		f += ddx;
+		if (sides & 0x1)
+		{
+			drawFastVLine(x0 + x, y0 - y, 2 * y + 1 + stretch, color);
+			drawFastVLine(x0 + y, y0 - x, 2 * x + 1 + stretch, color);
+		}
+		if (sides & 0x2)
+		{
+			drawFastVLine(x0 - x, y0 - y, 2 * y + 1 + stretch, color);
+			drawFastVLine(x0 - y, y0 - x, 2 * x + 1 + stretch, color);
+		}
+	}
+}
+
+void TFT_eSPI::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color)
+{
+	drawFastHLine(x + r, y, w - 2 * r, color);
+	drawFastHLine(x + r, y + h - 1, w - 2 * r, color);
+	drawFastVLine(x, y + r, h - 2 * r, color);
+	drawFastVLine(x + w - 1, y + r, h - 2 * r, color);
+	circleQuarter(x + r, y + r, r, 1, color);
+	circleQuarter(x + w - r - 1, y + r, r, 2, color);
+	circleQuarter(x + w - r - 1, y + h - r - 1, r, 4, color);
+	circleQuarter(x + r, y + h - r - 1, r, 8, color);
+}
+
+void TFT_eSPI::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color)
+{
+	fillRect(x + r, y, w - 2 * r, h, color);
+	fillCircleHalf(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+	fillCircleHalf(x + r, y + r, r, 2, h - 2 * r - 1, color);
+}
+
+void TFT_eSPI::drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color)
+{
+	drawPixel(x, y + r, color);
+	drawPixel(x, y - r, color);
+	drawPixel(x + r, y, color);
+	drawPixel(x - r, y, color);
+	circleQuarter(x, y, r, 0xF, color);
+}
+
+void TFT_eSPI::fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color)
+{
+	drawFastVLine(x, y - r, 2 * r + 1, color);
+	fillCircleHalf(x, y, r, 3, 0, color);
+}
+
+// ******************* Text ****************************
+
+//! Selects a GFX font and measures its extent above and below the baseline.
+void TFT_eSPI::setFreeFont(const GFXfont *font)
+{
+	_font = font;
+	_glyphAbove = 0;
+	_glyphBelow = 0;
+	if (font == nullptr)
+	{
+		return;
+	}
+	// like TFT_eSPI, the last glyph is not measured
+	for (uint16_t c = 0; c < font->last - font->first; c++)
+	{
+		const GFXglyph &glyph = font->glyph[c];
+		_glyphAbove = std::max<int16_t>(_glyphAbove, -glyph.yOffset);
+		_glyphBelow = std::max<int16_t>(_glyphBelow, glyph.height + glyph.yOffset);
+	}
+}
+
+void TFT_eSPI::setTextFont(uint8_t font)
+{
+	(void)font;
+	setFreeFont(nullptr);
+}
+
+void TFT_eSPI::setTextColor(uint16_t fg, uint16_t bg, bool fill)
+{
+	(void)fill;
+	_textColor = fg;
+	_textBgColor = bg;
+}
+
+void TFT_eSPI::setCursor(int16_t x, int16_t y)
+{
+	_cursorX = x;
+	_cursorY = y;
+}
+
+int16_t TFT_eSPI::fontHeight() const
+{
+	return (_font ? _font->yAdvance : 8) * _textSize;
+}
+
+int16_t TFT_eSPI::textWidth(const char *string) const
+{
+	int16_t width = 0;
+	for (const char *p = string; *p; p++)
+	{
+		if (_font == nullptr)
+		{
+			width += 6;
+		}
+		else if ((uint8_t)*p >= _font->first && (uint8_t)*p <= _font->last)
+		{
+			width += _font->glyph[(uint8_t)*p - _font->first].xAdvance;
+		}
+	}
+	return width * _textSize;
+}
+
+//! Draws one glyph with its baseline at y and returns its advance.
+int16_t TFT_eSPI::drawGlyph(char c, int32_t x, int32_t baseline)
+{
+	if (_font == nullptr)
+	{
+		return 6 * _textSize;
+	}
+	if ((uint8_t)c < _font->first || (uint8_t)c > _font->last)
+	{
+		return 0;
+	}
+	const GFXglyph &glyph = _font->glyph[(uint8_t)c - _font->first];
+	const uint8_t *bitmap = _font->bitmap + glyph.bitmapOffset;
+	uint32_t bit = 0;
+	for (int32_t row = 0; row < glyph.height; row++)
+	{
+		for (int32_t col = 0; col < glyph.width; col++, bit++)
+		{
+			if (bitmap[bit >> 3] & (0x80 >> (bit & 7)))
+			{
+				if (_textSize == 1)
+				{
+					drawPixel(x + glyph.xOffset + col, baseline + glyph.yOffset + row, _textColor);
+				}
+				else
+				{
+					fillRect(x + (glyph.xOffset + col) * _textSize, baseline + (glyph.yOffset + row) * _textSize,
+							 _textSize, _textSize, _textColor);
+				}
+			}
+		}
+	}
+	return glyph.xAdvance * _textSize;
+}
+
+/**
+ * @brief Draws a string placed by the text datum.
+ *
+ * @return Width of the string in pixels.
+ */
+int16_t TFT_eSPI::drawString(const char *string, int32_t x, int32_t y)
+{
+	int16_t width = textWidth(string);
+	int16_t above = (_font ? _glyphAbove : 7) * _textSize;
+	int16_t below = (_font ? _glyphBelow : 1) * _textSize;
+
+	switch (_datum % 3) // column of the datum
+	{
+	case 1:
+		x -= width / 2;
+		break;
+	case 2:
+		x -= width;
+		break;
+	}
+	int32_t baseline;
+	if (_datum >= L_BASELINE)
+	{
+		baseline = y;
+	}
+	else if (_datum >= BL_DATUM)
+	{
+		baseline = y - below;
+	}
+	else if (_datum >= ML_DATUM)
+	{
+		baseline = y - (above + below) / 2 + above;
+	}
+	else
+	{
+		baseline = y + above;
+	}
+
+	for (const char *p = string; *p; p++)
+	{
+		x += drawGlyph(*p, x, baseline);
+	}
+	return width;
+}
+
+int16_t TFT_eSPI::drawCentreString(const String &string, int32_t x, int32_t y, uint8_t font)
+{
+	(void)font;
+	uint8_t datum = _datum;
+	_datum = TC_DATUM;
+	int16_t width = drawString(string, x, y);
+	_datum = datum;
+	return width;
+}
+
+//! Print output at the cursor, cursor y being the baseline as in TFT_eSPI.
+size_t TFT_eSPI::write(uint8_t c)
+{
+	if (c == '\n')
+	{
+		_cursorX = 0;
+		_cursorY += fontHeight();
+	}
+	else if (c != '\r')
+	{
+		_cursorX += drawGlyph((char)c, _cursorX, _cursorY);
+	}
+	return 1;
+}
+
+// ******************* Screen dump *********************
+
+/**
+ * @brief Saves the display as a binary PPM image.
+ *
+ * @return false if there is no display or the file cannot be written.
+ */
+bool simWriteScreen(const char *path)
+{
+	if (screen == nullptr)
+	{
+		return false;
+	}
+	FILE *file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	fprintf(file, "P6\n%d %d\n255\n", screen->width(), screen->height());
+	for (int32_t y = 0; y < screen->height(); y++)
+	{
+		for (int32_t x = 0; x < screen->width(); x++)
+		{
+			uint16_t p = screen->readPixel(x, y);
+			uint8_t rgb[3] = {(uint8_t)((p >> 11) * 255 / 31), (uint8_t)(((p >> 5) & 0x3F) * 255 / 63),
+							  (uint8_t)((p & 0x1F) * 255 / 31)};
+			fwrite(rgb, 1, sizeof(rgb), file);
+		}
+	}
+	return fclose(file) == 0;
+}
+
+// End of file
@@ -0,0 +1,95 @@
+/**
+ * @file simTickTwo.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the host TickTwo timers.
+ */
+
+#include <TickTwo.h>
+
+TickTwo::TickTwo(fptr callback, uint32_t timer, uint32_t repeat, resolution_t resolution)
+	: _callback(callback), _timer(timer), _repeat(repeat), _resolution(resolution)
+{
+}
+
+void TickTwo::start()
+{
+	if (_callback == nullptr)
+	{
+		return;
+	}
+	_lastTime = now();
+	_enabled = true;
+	_counts = 0;
+	_status = RUNNING;
+}
+
+void TickTwo::resume()
+{
+	if (_callback == nullptr)
+	{
+		return;
+	}
+	_lastTime = now() - _diffTime;
+	if (_status == STOPPED)
+	{
+		_counts = 0;
+	}
+	_enabled = true;
+	_status = RUNNING;
+}
+
+void TickTwo::pause()
+{
+	_diffTime = now() - _lastTime;
+	_enabled = false;
+	_status = PAUSED;
+}
+
+void TickTwo::stop()
+{
+	_enabled = false;
+	_counts = 0;
+	_status = STOPPED;
+}
+
+void TickTwo::update()
+{
+	if (tick())
+	{
+		_callback();
+	}
+}
+
+void TickTwo::interval(uint32_t timer)
+{
+	_timer = timer;
+}
+
+uint32_t TickTwo::elapsed() const
+{
+	return now() - _lastTime;
+}
+
+bool TickTwo::tick()
+{
+	if (!_enabled)
+	{
+		return false;
+	}
+	uint32_t current = now();
+	if (current - _lastTime >= _timer)
+	{
+		_lastTime = current;
+		if (_repeat - _counts == 1 && _counts != 0xFFFFFFFF)
+		{
+			_enabled = false;
+			_status = STOPPED;
+		}
+		_counts++;
+		return true;
+	}
+	return false;
+}
+
+// End of file
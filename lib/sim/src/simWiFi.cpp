@@ -0,0 +1,221 @@
+/**
+ * @file simWiFi.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the host WiFi station and WiFiClient.
+ *
+ * Every call is non-blocking except connect(), which polls the pending
+ * connection for at most the Stream timeout.
+ */
+
+#include <ESP8266WiFi.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/sockios.h> // SIOCOUTQ
+#include "sim.h"
+
+ESP8266WiFiClass WiFi;
+
+/**
+ * @brief Looks up an IPv4 address.
+ *
+ * The host resolver does not take a timeout; a redirected host needs no lookup.
+ *
+ * @return 1 if found, 0 otherwise.
+ */
+int ESP8266WiFiClass::hostByName(const char *host, IPAddress &result, uint32_t timeoutMs)
+{
+	(void)timeoutMs;
+	bool redirected = simOptions.redirectHost != nullptr;
+	for (int i = 0; i < simOptions.endpointMapCount && !redirected; i++)
+	{
+		redirected = strcmp(host, simOptions.endpointMaps[i].host) == 0;
+	}
+	if (redirected)
+	{
+		result = IPAddress(127, 0, 0, 1);
+		return 1;
+	}
+
+	struct addrinfo hints = {};
+	hints.ai_family = AF_INET;
+	struct addrinfo *addrs = nullptr;
+	if (getaddrinfo(host, nullptr, &hints, &addrs) != 0 || addrs == nullptr)
+	{
+		return 0;
+	}
+	const uint8_t *ip = (const uint8_t *)&((struct sockaddr_in *)addrs->ai_addr)->sin_addr.s_addr;
+	result = IPAddress(ip[0], ip[1], ip[2], ip[3]);
+	freeaddrinfo(addrs);
+	return 1;
+}
+
+/**
+ * @brief Opens a TCP connection.
+ *
+ * A host given with --aprs-map goes to its local port, any other host to the
+ * --aprs address if one was given.
+ *
+ * @return 1 if connected within the Stream timeout, 0 otherwise.
+ */
+int WiFiClient::connect(const char *host, uint16_t port)
+{
+	stop();
+	bool mapped = false;
+	for (int i = 0; i < simOptions.endpointMapCount && !mapped; i++)
+	{
+		if (strcmp(host, simOptions.endpointMaps[i].host) == 0)
+		{
+			host = "127.0.0.1";
+			port = simOptions.endpointMaps[i].port;
+			mapped = true;
+		}
+	}
+	if (!mapped && simOptions.redirectHost != nullptr)
+	{
+		host = simOptions.redirectHost;
+		port = simOptions.redirectPort;
+	}
+
+	char service[8];
+	snprintf(service, sizeof(service), "%u", port);
+	struct addrinfo hints = {};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	struct addrinfo *addrs = nullptr;
+	if (getaddrinfo(host, service, &hints, &addrs) != 0)
+	{
+		return 0;
+	}
+
+	for (struct addrinfo *ai = addrs; ai != nullptr && _fd < 0; ai = ai->ai_next)
+	{
+		int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK, ai->ai_protocol);
+		if (fd < 0)
+		{
+			continue;
+		}
+		if (::connect(fd, ai->ai_addr, ai->ai_addrlen) != 0 && errno != EINPROGRESS)
+		{
+			close(fd);
+			continue;
+		}
+		struct pollfd pfd = {fd, POLLOUT, 0};
+		int error = 0;
+		socklen_t length = sizeof(error);
+		if (poll(&pfd, 1, (int)_timeout) != 1 ||
+			getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0)
+		{
+			close(fd);
+			continue;
+		}
+		_fd = fd;
+	}
+	freeaddrinfo(addrs);
+	return _fd >= 0 ? 1 : 0;
+}
+
+//! True while the connection is open or unread data remains.
+uint8_t WiFiClient::connected()
+{
+	if (_fd < 0)
+	{
+		return 0;
+	}
+	char c;
+	ssize_t n = recv(_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+	if (n > 0)
+	{
+		return 1;
+	}
+	if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+	{
+		return 1;
+	}
+	return 0; // closed by the peer or failed
+}
+
+void WiFiClient::stop()
+{
+	if (_fd >= 0)
+	{
+		close(_fd);
+		_fd = -1;
+	}
+}
+
+int WiFiClient::available()
+{
+	int count = 0;
+	if (_fd < 0 || ioctl(_fd, FIONREAD, &count) != 0)
+	{
+		return 0;
+	}
+	return count;
+}
+
+int WiFiClient::read()
+{
+	uint8_t c;
+	return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t *buf, size_t size)
+{
+	if (_fd < 0)
+	{
+		return -1;
+	}
+	ssize_t n = recv(_fd, buf, size, MSG_DONTWAIT);
+	return n > 0 ? (int)n : -1;
+}
+
+int WiFiClient::peek()
+{
+	uint8_t c;
+	if (_fd < 0 || recv(_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) != 1)
+	{
+		return -1;
+	}
+	return c;
+}
+
+//! Room left in a device-sized send buffer.
+int WiFiClient::availableForWrite()
+{
+	int queued = 0;
+	if (_fd < 0 || ioctl(_fd, SIOCOUTQ, &queued) != 0)
+	{
+		return 0;
+	}
+	return queued < SIM_TCP_SND_BUF ? SIM_TCP_SND_BUF - queued : 0;
+}
+
+size_t WiFiClient::write(const uint8_t *buf, size_t size)
+{
+	if (_fd < 0)
+	{
+		return 0;
+	}
+	ssize_t n = send(_fd, buf, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+	return n > 0 ? (size_t)n : 0;
+}
+
+void WiFiClient::setNoDelay(bool noDelay)
+{
+	int flag = noDelay ? 1 : 0;
+	if (_fd >= 0)
+	{
+		setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+	}
+}
+
+// End of file
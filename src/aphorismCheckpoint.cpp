@@ -0,0 +1,166 @@
+/**
+ * @file aphorismCheckpoint.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the aphorism rotation checkpoints.
+ *
+ * The RTC copy and the log records have the same layout, four 32-bit words,
+ * the last a check over the others, so a record that is half written or left
+ * over from other firmware is recognised.
+ */
+
+#include "aphorismCheckpoint.h"
+
+#include <Arduino.h>   // ESP.rtcUserMemoryRead()
+#include <LittleFS.h>  // checkpoint log
+#include "wug_debug.h" // debug print macro
+
+const char *APHORISM_CHECKPOINT_FILE = "/rotation.log";
+const char *APHORISM_CHECKPOINT_NEW = "/rotation.new"; // the log started over, until renamed
+const uint32_t APHORISM_CHECKPOINT_MAGIC = 0x31525041; // "APR1"
+
+//! One saved rotation, in RTC user memory and in the log
+struct AphorismCheckpointRecord
+{
+	uint32_t magic;
+	uint32_t seed;
+	uint32_t place; // position in the low 16 bits, size in the high 16
+	uint32_t check;
+};
+
+static_assert(sizeof(AphorismCheckpointRecord) % 4 == 0, "RTC memory is read in 4-byte blocks");
+
+static uint16_t picksSinceLog = 0; // picks since the last log record
+
+static uint32_t checkWord(const AphorismCheckpointRecord &record)
+{
+	uint32_t x = record.magic ^ (record.seed * 0x9e3779b1UL) ^ (record.place * 0x85ebca6bUL);
+	x ^= x >> 15;
+	return x * 0xc2b2ae35UL;
+}
+
+static AphorismCheckpointRecord makeRecord(const AphorismRotation &rotation)
+{
+	AphorismCheckpointRecord record;
+	record.magic = APHORISM_CHECKPOINT_MAGIC;
+	record.seed = rotation.seed;
+	record.place = rotation.position | ((uint32_t)rotation.size << 16);
+	record.check = checkWord(record);
+	return record;
+}
+
+//! Copies a record into rotation if it is intact and for a corpus of size lines.
+static bool useRecord(const AphorismCheckpointRecord &record, uint16_t size, AphorismRotation &rotation)
+{
+	if (record.magic != APHORISM_CHECKPOINT_MAGIC || record.check != checkWord(record) ||
+		(record.place >> 16) != size || (record.place & 0xFFFF) > size)
+	{
+		return false;
+	}
+	rotation.seed = record.seed;
+	rotation.position = (uint16_t)(record.place & 0xFFFF);
+	rotation.size = size;
+	return true;
+}
+
+/**
+ * @brief Appends a record to the log, starting the log over when it is full or ends in a torn record.
+ *
+ * A log that starts over is written as a new file holding just this record and
+ * renamed over the old one. LittleFS renames atomically, so a power loss at any
+ * point leaves either the old log or the new one, never a log without a record.
+ */
+static bool appendRecord(const AphorismCheckpointRecord &record)
+{
+	File log = LittleFS.open(APHORISM_CHECKPOINT_FILE, "a");
+	if (!log)
+	{
+		return false;
+	}
+	if (log.size() < APHORISM_CHECKPOINT_RECORDS * sizeof(record) && log.size() % sizeof(record) == 0)
+	{
+		bool written = log.write((const uint8_t *)&record, sizeof(record)) == sizeof(record);
+		log.close();
+		return written;
+	}
+	log.close();
+
+	File fresh = LittleFS.open(APHORISM_CHECKPOINT_NEW, "w");
+	if (!fresh)
+	{
+		return false;
+	}
+	bool written = fresh.write((const uint8_t *)&record, sizeof(record)) == sizeof(record);
+	fresh.close();
+	return written && LittleFS.rename(APHORISM_CHECKPOINT_NEW, APHORISM_CHECKPOINT_FILE);
+}
+
+/**
+ * @brief Saves the rotation after a pick.
+ *
+ * Always to RTC user memory; to the LittleFS log every
+ * APHORISM_CHECKPOINT_PICKS calls.
+ *
+ * @return false if the log record could not be written.
+ */
+bool saveAphorismRotation(const AphorismRotation &rotation)
+{
+	AphorismCheckpointRecord record = makeRecord(rotation);
+	ESP.rtcUserMemoryWrite(APHORISM_RTC_OFFSET, (uint32_t *)&record, sizeof(record));
+	if (++picksSinceLog < APHORISM_CHECKPOINT_PICKS)
+	{
+		return true;
+	}
+	picksSinceLog = 0;
+	if (!appendRecord(record))
+	{
+		DEBUG_PRINTLN("FS failed to save rotation");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Finds where the rotation was before the reboot.
+ *
+ * Reads one RTC record and at most two log records, whatever the length of
+ * the log. Call after LittleFS is mounted.
+ *
+ * @param rotation Receives the rotation if one is found.
+ * @param size     Aphorisms in the corpus now.
+ * @return Where the rotation came from, RESTORE_NONE if rotation is unchanged.
+ */
+AphorismRestore restoreAphorismRotation(AphorismRotation &rotation, uint16_t size)
+{
+	picksSinceLog = 0;
+	AphorismCheckpointRecord record;
+	if (ESP.rtcUserMemoryRead(APHORISM_RTC_OFFSET, (uint32_t *)&record, sizeof(record)) &&
+		useRecord(record, size, rotation))
+	{
+		return RESTORE_RTC;
+	}
+
+	File log = LittleFS.open(APHORISM_CHECKPOINT_FILE, "r");
+	if (!log)
+	{
+		return RESTORE_NONE;
+	}
+	size_t records = log.size() / sizeof(record);
+	for (size_t back = 1; back <= 2 && back <= records; back++)
+	{
+		if (log.seek((records - back) * sizeof(record)) &&
+			(int)log.read((uint8_t *)&record, sizeof(record)) == (int)sizeof(record) &&
+			useRecord(record, size, rotation))
+		{
+			// up to a log interval of picks were made after this record
+			uint32_t position = rotation.position + APHORISM_CHECKPOINT_PICKS;
+			rotation.position = (uint16_t)(position < size ? position : size);
+			log.close();
+			appendRecord(makeRecord(rotation)); // so another reboot does not go back
+			return RESTORE_LOG;
+		}
+	}
+	return RESTORE_NONE;
+}
+
+// End of file
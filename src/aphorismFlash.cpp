@@ -0,0 +1,51 @@
+/**
+ * @file aphorismFlash.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Reads aphorisms from the PROGMEM corpus.
+ */
+
+#include "aphorismFlash.h"
+
+#include "aphorismCorpus.h" // generated by build_corpus.py
+
+//! Number of aphorisms in flash.
+int flashAphorismCount()
+{
+	return APHORISM_FLASH_RECORDS;
+}
+
+/**
+ * @brief Copies one aphorism out of flash.
+ *
+ * @param line Record number, 0 to flashAphorismCount() - 1.
+ * @param text Receives the aphorism, null-terminated.
+ * @param size Room in text, including the terminator; longer records are cut.
+ * @return Characters copied, 0 if line is out of range.
+ */
+size_t readFlashAphorism(int line, char *text, size_t size)
+{
+	if (line < 0 || line >= APHORISM_FLASH_RECORDS || size == 0)
+	{
+		return 0;
+	}
+	uint16_t start = pgm_read_word(&APHORISM_FLASH_OFFSETS[line]);
+	size_t length = pgm_read_word(&APHORISM_FLASH_OFFSETS[line + 1]) - start;
+	if (length > size - 1)
+	{
+		length = size - 1;
+	}
+	memcpy_P(text, APHORISM_FLASH_TEXT + start, length);
+	text[length] = '\0';
+	return length;
+}
+
+//! One aphorism as a String, empty if line is out of range.
+String flashAphorism(int line)
+{
+	char text[256];
+	readFlashAphorism(line, text, sizeof(text));
+	return String(text);
+}
+
+// End of file
@@ -9,9 +9,30 @@
  * and selecting a random aphorism for display or use elsewhere in the application.
  *
  * Key Functions:
- * - mountFS(): Mounts the filesystem, counts aphorisms, and initializes a shuffled index array.
- * - shuffleArray(): Implements the Fisher-Yates shuffle to randomize the order of aphorisms.
- * - pickAphorism(): Retrieves an aphorism from the file based on the shuffled index array.
+ * - mountFS(): Mounts the filesystem, indexes the aphorisms, and starts the rotation.
+ * - readAphorismLine(): Retrieves one line of an aphorism file.
+ * - pickAphorism(): Retrieves the next aphorism of the rotation.
+ *
+ * Rotation:
+ * The order of the picks is a permutation computed from a seed (aphorismRotation.h), so no
+ * array of line numbers is kept. Each cycle picks every aphorism once; the next cycle gets
+ * a new seed from the ESP8266 hardware random number generator. The rotation is saved after
+ * every pick and resumed after a reboot (aphorismCheckpoint.h).
+ *
+ * Line index:
+ * The start of every line is kept as a 16-bit offset, so a pick is one seek() and one
+ * bounded read through a file handle that stays open. The table is cached in a sidecar
+ * file (APHORISM_FILE + ".idx") and rebuilt when the aphorism file's size changes.
+ * A file over 64 KB is not indexed and is scanned line by line as before.
+ *
+ * Packed corpus:
+ * build_corpus.py compiles the aphorism file into APHORISM_CORPUS at build time, with the
+ * offsets table built in and each aphorism a length byte and clean ASCII text. When that
+ * file is present and consistent it is used instead, so nothing is counted at startup.
+ *
+ * Flash corpus:
+ * Built with -DAPHORISM_PROGMEM, the same records are read from the PROGMEM arrays of
+ * aphorismFlash.cpp and the file system is only mounted for the other modules.
  *
  * Dependencies:
  * - LittleFS for file storage and access.
@@ -23,29 +44,274 @@
 
 #include <Arduino.h>     // Arduino functions
 #include <LittleFS.h>    // [builtin]
-#include "credentials.h" // Wi-Fi and weather station credentials
-#include "wug_debug.h"   // for debug print
+#include "aphorismCheckpoint.h" // rotation kept across reboots
+#include "aphorismFlash.h"    // flashAphorism()
+#include "aphorismRotation.h" // order of the picks
+#include "aprsMetrics.h"      // pick timing
+#include "credentials.h"      // Wi-Fi and weather station credentials
+#include "wug_debug.h"        // for debug print
+
+int lineCount = 0;                // number of aphorisms in file
+static AphorismRotation rotation; // seed and position of the picks
+
+#ifndef APHORISM_PROGMEM
+const uint32_t APHORISM_INDEX_MAGIC = 0x31585041;  // "APX1"
+const uint32_t APHORISM_CORPUS_MAGIC = 0x31435041; // "APC1", see build_corpus.py
+const char *APHORISM_INDEX_SUFFIX = ".idx";       // sidecar file name suffix
+const int APHORISM_LINE_MAX = 200;                // longest line returned by a pick
+const size_t APHORISM_SCAN_CHUNK = 128;           // bytes read at a time while indexing
+
+static File aphorismFile;                 // kept open for picks
+static uint16_t *lineOffsets = nullptr;   // start of each line, then the file size
+static int indexedLines = 0;              // lines in lineOffsets
+static bool corpusPacked = false;         // aphorismFile is the packed corpus
+
+//! Header of the sidecar index file and of the packed corpus, followed by lines + 1 offsets
+struct AphorismIndexHeader
+{
+  uint32_t magic;
+  uint32_t corpusSize; // size of the aphorism file when indexed, or of the packed corpus
+  uint32_t lines;
+};
+
+/**
+ * @brief Counts the lines of the open aphorism file and, if offsets is not null,
+ *        records where each one starts.
+ *
+ * Reads in small chunks instead of a String per line. A last line without a
+ * newline counts; a newline at the very end does not start another line.
+ */
+static int scanAphorismLines(uint16_t *offsets)
+{
+  uint8_t chunk[APHORISM_SCAN_CHUNK];
+  size_t size = aphorismFile.size();
+  size_t pos = 0;
+  int lines = 0;
+  bool lineStart = true;
+  aphorismFile.seek(0);
+  while (pos < size)
+  {
+    int got = (int)aphorismFile.read(chunk, sizeof(chunk));
+    if (got <= 0)
+    {
+      break;
+    }
+    for (int i = 0; i < got; i++, pos++)
+    {
+      if (lineStart)
+      {
+        if (offsets != nullptr)
+        {
+          offsets[lines] = (uint16_t)pos;
+        }
+        lines++;
+        lineStart = false;
+      }
+      lineStart = (chunk[i] == '\n');
+    }
+  }
+  if (offsets != nullptr)
+  {
+    offsets[lines] = (uint16_t)size;
+  }
+  return lines;
+}
+
+//! Reads the sidecar index if it matches the aphorism file.
+static bool loadAphorismIndex(const String &indexName)
+{
+  File index = LittleFS.open(indexName.c_str(), "r");
+  if (!index)
+  {
+    return false;
+  }
+  AphorismIndexHeader header;
+  if ((int)index.read((uint8_t *)&header, sizeof(header)) != (int)sizeof(header) ||
+      header.magic != APHORISM_INDEX_MAGIC || header.corpusSize != aphorismFile.size() ||
+      header.lines == 0 || index.size() != sizeof(header) + (header.lines + 1) * sizeof(uint16_t))
+  {
+    return false;
+  }
+  lineOffsets = new uint16_t[header.lines + 1];
+  size_t bytes = (header.lines + 1) * sizeof(uint16_t);
+  if ((int)index.read((uint8_t *)lineOffsets, bytes) != (int)bytes || lineOffsets[header.lines] != header.corpusSize)
+  {
+    delete[] lineOffsets;
+    lineOffsets = nullptr;
+    return false;
+  }
+  indexedLines = header.lines;
+  return true;
+}
+
+/**
+ * @brief Opens the packed corpus and loads its offsets table.
+ *
+ * The offsets must start right after the table, rise with every record and end at
+ * the file size, so every pick reads a whole record of the file.
+ */
+static bool loadAphorismCorpus()
+{
+  File corpus = LittleFS.open(APHORISM_CORPUS.c_str(), "r");
+  if (!corpus)
+  {
+    return false;
+  }
+  AphorismIndexHeader header;
+  if ((int)corpus.read((uint8_t *)&header, sizeof(header)) != (int)sizeof(header) ||
+      header.magic != APHORISM_CORPUS_MAGIC || header.corpusSize != corpus.size() ||
+      header.lines == 0 || header.corpusSize > 0xFFFF)
+  {
+    DEBUG_PRINTLN("FS corpus not valid");
+    return false;
+  }
+  uint16_t *offsets = new uint16_t[header.lines + 1];
+  size_t bytes = (header.lines + 1) * sizeof(uint16_t);
+  bool valid = (int)corpus.read((uint8_t *)offsets, bytes) == (int)bytes &&
+               offsets[0] == sizeof(header) + bytes && offsets[header.lines] == header.corpusSize;
+  for (uint32_t i = 0; valid && i < header.lines; i++)
+  {
+    valid = offsets[i + 1] > offsets[i] + 1 && offsets[i + 1] - offsets[i] <= APHORISM_LINE_MAX + 1;
+  }
+  if (!valid)
+  {
+    DEBUG_PRINTLN("FS corpus not valid");
+    delete[] offsets;
+    return false;
+  }
+  aphorismFile = corpus;
+  lineOffsets = offsets;
+  indexedLines = header.lines;
+  corpusPacked = true;
+  return true;
+}
 
-int *lineArray = nullptr; // holds shuffled index to aphorisms
-int lineArraySize = 0;    // tracks the size of the lineArray
+//! Indexes the aphorism file and saves the index beside it.
+static void buildAphorismIndex(const String &indexName)
+{
+  indexedLines = scanAphorismLines(nullptr);
+  if (indexedLines == 0 || aphorismFile.size() > 0xFFFF)
+  {
+    return; // nothing to index, or too big for 16-bit offsets
+  }
+  lineOffsets = new uint16_t[indexedLines + 1];
+  scanAphorismLines(lineOffsets);
+
+  File index = LittleFS.open(indexName.c_str(), "w");
+  if (!index)
+  {
+    DEBUG_PRINTLN("FS failed to save index");
+    return;
+  }
+  AphorismIndexHeader header = {APHORISM_INDEX_MAGIC, (uint32_t)aphorismFile.size(), (uint32_t)indexedLines};
+  index.write((const uint8_t *)&header, sizeof(header));
+  index.write((const uint8_t *)lineOffsets, (indexedLines + 1) * sizeof(uint16_t));
+  index.close();
+}
 
 /**
- * @brief Mounts the LittleFS filesystem, counts the number of lines in the aphorism file,
- *        and initializes a shuffled array of line indices for random access.
+ * @brief Reads one line through the index: one seek and one bounded read.
+ *
+ * The line ending is removed; lines longer than APHORISM_LINE_MAX are cut.
+ * A record of the packed corpus is its length byte and the text, at most
+ * APHORISM_LINE_MAX + 1 bytes as loadAphorismCorpus() checks, so it is always
+ * read whole.
+ */
+static String readIndexedAphorism(int line)
+{
+  char text[APHORISM_LINE_MAX + 2]; // length byte or line ending, and the terminator
+  size_t length = lineOffsets[line + 1] - lineOffsets[line];
+  if (length > (size_t)APHORISM_LINE_MAX + 1)
+  {
+    length = APHORISM_LINE_MAX + 1;
+  }
+  if (!aphorismFile.seek(lineOffsets[line]))
+  {
+    return "";
+  }
+  int got = (int)aphorismFile.read((uint8_t *)text, length);
+  length = (got > 0) ? (size_t)got : 0;
+  if (corpusPacked)
+  {
+    if (length == 0 || (uint8_t)text[0] != length - 1)
+    {
+      return "";
+    }
+    text[length] = '\0';
+    return String(text + 1);
+  }
+  while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+  {
+    length--;
+  }
+  if (length > (size_t)APHORISM_LINE_MAX)
+  {
+    length = APHORISM_LINE_MAX;
+  }
+  text[length] = '\0';
+  return String(text);
+}
+#endif // APHORISM_PROGMEM
+
+//! true if the aphorism file is read from flash or through an index, without scanning.
+static bool aphorismsIndexed()
+{
+#ifdef APHORISM_PROGMEM
+  return true;
+#else
+  return lineOffsets != nullptr;
+#endif
+}
+
+//! Reads one aphorism of the corpus, from flash or through the index.
+static bool readAphorism(int line, String &aphorism)
+{
+#ifdef APHORISM_PROGMEM
+  if (line < 0 || line >= flashAphorismCount())
+  {
+    return false;
+  }
+  aphorism = flashAphorism(line);
+#else
+  if (lineOffsets == nullptr || line < 0 || line >= indexedLines)
+  {
+    return false;
+  }
+  aphorism = readIndexedAphorism(line);
+#endif
+  return true;
+}
+
+/**
+ * @brief Mounts the LittleFS filesystem, sets up the line index of the aphorisms,
+ *        and starts or resumes the seeded permutation that orders the picks.
  *
  * This function attempts to mount the LittleFS filesystem. If mounting fails, it logs an error and returns.
- * Upon successful mounting, it opens the aphorism file specified by APHORISM_FILE in read mode.
- * It then counts the number of lines in the file to determine how many aphorisms are available.
- * After counting, it initializes an array of integers (lineArray) with indices corresponding to each line,
- * and shuffles the array using a Fisher-Yates shuffle algorithm seeded with analog noise for better randomness.
- * This shuffled array can be used to access aphorisms in a random order without repetition.
+ * Upon successful mounting, it opens the packed corpus APHORISM_CORPUS, whose offsets table is read as it is.
+ * Without one, it opens the aphorism file specified by APHORISM_FILE in read mode and keeps it open.
+ * The line index is loaded from the sidecar file, or built by one pass over the file and saved if the
+ * sidecar is missing or was made for a file of another size. The index gives the number of aphorisms.
+ * After counting, it resumes the rotation saved before a reboot, or starts one with a seed from the
+ * hardware random number generator, so pickAphorism() returns the aphorisms in a random order
+ * without repetition.
  *
- * @note Assumes that APHORISM_FILE, lineArray, and lineArraySize are defined elsewhere.
+ * @note Sets lineCount; APHORISM_FILE and APHORISM_CORPUS come from credentials.cpp.
  * @note Uses DEBUG_PRINT and DEBUG_PRINTLN macros for logging.
  * @note Requires LittleFS and random number generation to be available.
  */
 void mountFS()
 {
+#ifdef APHORISM_PROGMEM
+  if (!LittleFS.begin())
+  {
+    DEBUG_PRINTLN("FS error"); // the aphorisms are in flash and still work
+  }
+  else
+  {
+    DEBUG_PRINTLN("FS mounted");
+  }
+  lineCount = flashAphorismCount();
+#else
   if (!LittleFS.begin())
   {
     DEBUG_PRINTLN("FS error");
@@ -53,130 +319,112 @@ void mountFS()
   }
   DEBUG_PRINTLN("FS mounted");
 
-  File file = LittleFS.open(APHORISM_FILE, "r");
-  if (!file)
+  delete[] lineOffsets;
+  lineOffsets = nullptr;
+  indexedLines = 0;
+  corpusPacked = false;
+  if (loadAphorismCorpus())
   {
-    DEBUG_PRINTLN("FS failed to open file");
+    DEBUG_PRINTLN("FS using " + APHORISM_CORPUS);
   }
-  /************** Count Lines in File *******************/
-  int lineCount = 0;
-  while (file.available())
+  else
   {
-    file.readStringUntil('\n');
-    lineCount++;
+    aphorismFile = LittleFS.open(APHORISM_FILE, "r");
+    if (!aphorismFile)
+    {
+      DEBUG_PRINTLN("FS failed to open file");
+      return;
+    }
+    /************** Index Lines in File *******************/
+    String indexName = APHORISM_FILE + APHORISM_INDEX_SUFFIX;
+    if (!loadAphorismIndex(indexName))
+    {
+      DEBUG_PRINTLN("FS building aphorism index");
+      buildAphorismIndex(indexName);
+    }
   }
-  file.close();
+  lineCount = indexedLines;
+#endif
 
   DEBUG_PRINT("FS: ");
   DEBUG_PRINT(lineCount);
   DEBUG_PRINTLN(" lines in " + APHORISM_FILE);
 
-  // Create and shuffle the array directly during initialization
-  lineArraySize = lineCount;
-  lineArray = new int[lineArraySize];
-  randomSeed(analogRead(0)); // Seed with analog noise from pin 0 for better entropy
-  for (int i = 0; i < lineCount; i++)
+  // the order of the picks, a new permutation each cycle, resumed where it was before a reboot
+  uint16_t size = (uint16_t)min(lineCount, 0xFFFF);
+  AphorismRestore restored = restoreAphorismRotation(rotation, size);
+  if (restored == RESTORE_NONE)
   {
-    int j = random(0, i + 1);                   // Generate a random index
-    lineArray[i] = (j == i) ? i : lineArray[j]; // Place the new index or swap with an existing one
-    lineArray[j] = i;
+    startAphorismRotation(rotation, size, ESP.random()); // hardware random number generator
   }
+  DEBUG_PRINT("Rotation at ");
+  DEBUG_PRINT(rotation.position);
+  DEBUG_PRINTLN(restored == RESTORE_RTC ? " from RTC" : (restored == RESTORE_LOG ? " from log" : ", new"));
 } // mountFS()
 
 /**
- * @brief Shuffles the elements of an integer array in place using the Fisher-Yates algorithm.
- *
- * This function randomly permutes the elements of the given array, ensuring each possible
- * permutation is equally likely. It iterates from the end of the array to the beginning,
- * swapping each element with another randomly selected element that comes before it (or itself).
+ * @brief Reads one line of an aphorism file.
  *
- * @param array Pointer to the integer array to be shuffled.
- * @param size The number of elements in the array.
+ * The aphorism file is read through its line index and the handle mountFS() left open,
+ * or from flash with APHORISM_PROGMEM, so a line past the end costs no more than any other.
+ * Other files, and an aphorism file that could not be indexed, are scanned once from the start.
  *
- * @note Uses the random() function to generate random indices. For improved randomness,
- *       consider seeding the random number generator with randomSeed() before calling this function.
+ * @param fileName The name of the file containing aphorisms, one per line.
+ * @param line     The line to read, counted from 0.
+ * @return         The aphorism string from the specified line, or an empty string on failure.
  */
-void shuffleArray(int *array, int size)
+String readAphorismLine(String fileName, int line)
 {
-  // Fisher-Yates shuffle algorithm
-  // This algorithm iterates through the array from the last element to the second.
-  // For each element, it selects a random index (j) between 0 and the current index (i).
-  // The elements at indices i and j are then swapped, ensuring a uniform shuffle.
-  // random() is used to generate the random index, and it can be seeded with randomSeed() for better randomness.
-
-  for (int i = size - 1; i > 0; i--)
+  if (fileName == APHORISM_FILE && aphorismsIndexed())
   {
-    int j = random(0, i + 1); // Generate a random index between 0 and i (inclusive)
-    // Swap array[i] with the element at random index j
-    int temp = array[i];
-    array[i] = array[j];
-    array[j] = temp;
+    String indexed; // stays empty past the end of the corpus
+    readAphorism(line, indexed);
+    return indexed;
   }
-} // shuffleArray()
-
-/**
- * @brief Picks an aphorism from a file based on a sequence of line numbers.
- *
- * This function retrieves a specific line (aphorism) from a file stored in the filesystem,
- * using the provided array of line numbers. It maintains an internal static index to cycle
- * through the line numbers on each call. If the end of the array is reached (indicated by -1),
- * the index resets to the beginning. The function attempts up to 10 times to read the desired
- * line from the file, returning an empty string on failure.
- *
- * @param fileName   The name of the file containing aphorisms, one per line.
- * @param lineArray  Pointer to an array of integers specifying the line numbers to pick.
- *                   The array should be terminated with -1.
- * @return           The aphorism string from the specified line, or an empty string on failure.
- */
-String pickAphorism(String fileName, int *lineArray)
-{
-  static int j = 0; // Static variable to retain value between function calls
 
-  if (lineArray == nullptr)
+  File file = LittleFS.open(fileName.c_str(), "r");
+  if (!file)
   {
-    return ""; // Return an empty string if lineArray is not initialized
+    DEBUG_PRINTLN("FS failed to open file");
+    return ""; // Return empty string on failure
   }
 
-  for (int attempt = 0; attempt < 10; attempt++)
-  { // Limit attempts to prevent infinite loop
-    File file = LittleFS.open(fileName.c_str(), "r");
-    if (!file)
-    {
-      DEBUG_PRINTLN("FS failed to open file");
-      return ""; // Return empty string on failure
-    }
-
-    String aphorism = "";
-    int targetLine = lineArray[j];
-    int currentLine = 0;
-
-    // Search for the target line
-    while (file.available())
-    {
-      String line = file.readStringUntil('\n');
-      if (currentLine == targetLine)
-      {
-        aphorism = line;
-        break;
-      }
-      currentLine++;
-    }
-
-    file.close(); // Ensure file is closed
-
-    if (currentLine == targetLine)
+  // Search for the target line, in one pass
+  String aphorism = "";
+  int currentLine = 0;
+  while (file.available())
+  {
+    String text = file.readStringUntil('\n');
+    if (currentLine == line)
     {
-      j++; // Increment j for the next call
-      if (lineArray[j] == -1)
-      {        // Assuming the end of the array is marked with -1
-        j = 0; // Reset j if it reaches the end of the array
-      }
-      return aphorism; // Return found aphorism
+      aphorism = text;
+      break;
     }
+    currentLine++;
   }
+  file.close(); // Ensure file is closed
+  return aphorism; // empty if the file has no such line
+}
 
-  j = 0;     // Reset j if no valid aphorism is found
-  return ""; // Return empty string if unsuccessful
+/**
+ * @brief Picks the next aphorism of the rotation.
+ *
+ * Every aphorism is picked once per cycle, in the order of the cycle's permutation;
+ * the position is the only state that changes between calls, and it is saved each time.
+ *
+ * @param fileName The name of the file containing aphorisms, one per line.
+ * @return         The aphorism, or an empty string if there are none or the read failed.
+ */
+String pickAphorism(String fileName)
+{
+  MetricScope timing(METRIC_PICK_APHORISM);
+  int line = nextAphorismIndex(rotation, ESP.random());
+  if (line < 0)
+  {
+    return ""; // Return an empty string before mountFS() found any aphorisms
+  }
+  saveAphorismRotation(rotation);
+  return readAphorismLine(fileName, line);
 }
 
-// End of file
\ No newline at end of file
+// End of file
@@ -0,0 +1,102 @@
+/**
+ * @file aphorismRotation.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the aphorism permutation.
+ *
+ * The Feistel network is a bijection on [0, 4^h) whatever the round function,
+ * so walking from index through it until a value below size comes up is a
+ * bijection on [0, size). The range is less than four times size, so a walk
+ * takes fewer than four steps on average.
+ */
+
+#include "aphorismRotation.h"
+
+const int APHORISM_FEISTEL_ROUNDS = 4;
+
+//! Mixes the bits of x, an invertible 32-bit hash
+static uint32_t mix32(uint32_t x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352dUL;
+	x ^= x >> 15;
+	x *= 0x846ca68bUL;
+	x ^= x >> 16;
+	return x;
+}
+
+/**
+ * @brief Maps position index of the cycle selected by seed to a line.
+ *
+ * @param seed  Selects the permutation.
+ * @param index Position in the cycle, below size.
+ * @param size  Aphorisms in the corpus, at least 1.
+ * @return The line, below size; every index gives a different one.
+ */
+uint16_t permuteAphorismIndex(uint32_t seed, uint16_t index, uint16_t size)
+{
+	int halfBits = 1; // bits in each half, 4^halfBits >= size
+	while ((1UL << (2 * halfBits)) < size)
+	{
+		halfBits++;
+	}
+	const uint32_t mask = (1UL << halfBits) - 1;
+	uint32_t keys[APHORISM_FEISTEL_ROUNDS];
+	for (int round = 0; round < APHORISM_FEISTEL_ROUNDS; round++)
+	{
+		keys[round] = mix32(seed + 0x9e3779b9UL * (round + 1));
+	}
+
+	uint32_t x = index;
+	do
+	{
+		uint32_t left = x >> halfBits;
+		uint32_t right = x & mask;
+		for (int round = 0; round < APHORISM_FEISTEL_ROUNDS; round++)
+		{
+			uint32_t next = left ^ (mix32(right ^ keys[round]) & mask);
+			left = right;
+			right = next;
+		}
+		x = (left << halfBits) | right;
+	} while (x >= size); // cycle-walk back into the corpus
+	return (uint16_t)x;
+}
+
+//! Starts the first cycle over size aphorisms.
+void startAphorismRotation(AphorismRotation &rotation, uint16_t size, uint32_t seed)
+{
+	rotation.seed = seed;
+	rotation.position = 0;
+	rotation.size = size;
+}
+
+/**
+ * @brief Returns the next line of the rotation.
+ *
+ * @param rotation  State, advanced by one pick.
+ * @param freshSeed Seed for the next cycle, used only when this one is done.
+ * @return The line, or -1 if the corpus is empty.
+ */
+int nextAphorismIndex(AphorismRotation &rotation, uint32_t freshSeed)
+{
+	if (rotation.size == 0)
+	{
+		return -1;
+	}
+	if (rotation.position >= rotation.size)
+	{
+		uint16_t last = permuteAphorismIndex(rotation.seed, rotation.size - 1, rotation.size);
+		rotation.seed = freshSeed;
+		for (int attempt = 0; attempt < 8 && rotation.size > 1 &&
+							  permuteAphorismIndex(rotation.seed, 0, rotation.size) == last;
+			 attempt++)
+		{
+			rotation.seed = mix32(rotation.seed + 1); // no repeat across the cycles
+		}
+		rotation.position = 0;
+	}
+	return permuteAphorismIndex(rotation.seed, rotation.position++, rotation.size);
+}
+
+// End of file
@@ -0,0 +1,214 @@
+/**
+ * @file aprsBulletins.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the APRS bulletin scheduler.
+ *
+ * All times are local time_t values from myTZ. Adding a day to a local time
+ * keeps the wall-clock time across daylight saving changes; ezTime converts
+ * the event time to UTC when it is set.
+ */
+
+#include "aprsBulletins.h"
+
+#include <Arduino.h>		   // Arduino functions
+#include <ezTime.h>			   // events, makeTime()
+#include "aphorismGenerator.h" // pickAphorism()
+#include "aprsMultipart.h"	   // sendAPRSText()
+#include "aprsService.h"	   // aprsSessionMillis()
+#include "credentials.h"	   // APHORISM_FILE
+#include "timeFunctions.h"	   // myTZ
+#include "wug_debug.h"		   // debug print macro
+
+// bulletins by local time, pg 83
+const APRSBulletinEntry APRS_BULLETIN_SCHEDULE[] = {
+	{8, 0, 'M', BULLETIN_APHORISM},	 // morning
+	{20, 0, 'E', BULLETIN_APHORISM}, // evening
+};
+const int APRS_BULLETIN_COUNT = sizeof(APRS_BULLETIN_SCHEDULE) / sizeof(APRS_BULLETIN_SCHEDULE[0]);
+
+const time_t SECONDS_PER_DAY = 86400;
+const unsigned long APRS_BULLETIN_PICK_RETRY = 60000L; // milliseconds between failed picks
+
+APRSBulletinStats bulletinStats;
+
+static time_t nextLocal[APRS_BULLETIN_COUNT]; // next occurrence of each entry
+static time_t dueLocal[APRS_BULLETIN_COUNT];  // occurrence waiting to be sent, 0 if none
+static bool scheduled = false;				  // nextLocal has been worked out
+
+static char preparedText[APRS_MULTIPART_TEXT_MAX + 1] = ""; // aphorism for the next bulletin
+static unsigned long lastPickMs = 0;				 // millis() of the last failed pick
+static bool pickFailed = false;
+
+//! First time after local time t that the entry's hour:minute comes round.
+static time_t nextOccurrence(const APRSBulletinEntry &entry, time_t t)
+{
+	time_t at = makeTime(entry.hour, entry.minute, 0, myTZ.day(t), myTZ.month(t), myTZ.year(t));
+	if (at <= t)
+	{
+		at += SECONDS_PER_DAY;
+	}
+	return at;
+}
+
+static void onBulletinTime();
+
+//! Sets the one ezTime event for the earliest next occurrence.
+static void armBulletinEvent()
+{
+	time_t earliest = nextLocal[0];
+	for (int i = 1; i < APRS_BULLETIN_COUNT; i++)
+	{
+		if (nextLocal[i] < earliest)
+		{
+			earliest = nextLocal[i];
+		}
+	}
+	deleteEvent(onBulletinTime);
+	myTZ.setEvent(onBulletinTime, earliest);
+}
+
+/**
+ * @brief Runs from events() when the earliest entry comes due.
+ *
+ * Marks every entry whose time has passed, however late events() ran, and
+ * moves it to its next occurrence, so each occurrence is marked once.
+ */
+static void onBulletinTime()
+{
+	time_t now = myTZ.now();
+	for (int i = 0; i < APRS_BULLETIN_COUNT; i++)
+	{
+		if (nextLocal[i] > now)
+		{
+			continue;
+		}
+		if (dueLocal[i] != 0)
+		{
+			bulletinStats.missed++; // the previous one was never sent
+		}
+		dueLocal[i] = nextLocal[i];
+		nextLocal[i] = nextOccurrence(APRS_BULLETIN_SCHEDULE[i], now);
+	}
+	armBulletinEvent();
+}
+
+/**
+ * @brief Picks the aphorism for the next bulletin.
+ *
+ * Aphorisms too long for one bulletin are sent in parts; only those longer
+ * than APRS_MULTIPART_TEXT_MAX are passed over. After a failed pick,
+ * e.g. before the file system is mounted, waits APRS_BULLETIN_PICK_RETRY
+ * unless force is set.
+ */
+static void prepareBulletinText(bool force)
+{
+	if (!force && pickFailed && millis() - lastPickMs < APRS_BULLETIN_PICK_RETRY)
+	{
+		return;
+	}
+	for (int attempt = 0; attempt < 3; attempt++)
+	{
+		String text = pickAphorism(APHORISM_FILE);
+		text.trim();
+		if (text.length() > 0 && text.length() <= (unsigned)APRS_MULTIPART_TEXT_MAX)
+		{
+			strcpy(preparedText, text.c_str());
+			pickFailed = false;
+			return;
+		}
+	}
+	pickFailed = true;
+	lastPickMs = millis();
+}
+
+/**
+ * @brief Sends entry i if APRS-IS is logged on, or drops it if too late.
+ */
+static void sendDueBulletin(int i)
+{
+	const APRSBulletinEntry &entry = APRS_BULLETIN_SCHEDULE[i];
+	time_t late = myTZ.now() - dueLocal[i];
+	if (late > APRS_BULLETIN_CATCHUP)
+	{
+		DEBUG_PRINTLN(F("APRS bulletin missed"));
+		bulletinStats.missed++;
+		dueLocal[i] = 0;
+		return;
+	}
+	if (aprsSessionMillis() == 0)
+	{
+		return; // wait for the logon
+	}
+
+	switch (entry.source)
+	{
+	case BULLETIN_APHORISM:
+		if (preparedText[0] == '\0')
+		{
+			prepareBulletinText(true);
+		}
+		break;
+	}
+
+	char id[] = {entry.id, '\0'};
+	if (preparedText[0] == '\0' || !sendAPRSText(MULTIPART_BULLETIN, id, preparedText, strlen(preparedText)))
+	{
+		DEBUG_PRINTLN(F("APRS bulletin not sent"));
+		bulletinStats.failed++;
+	}
+	else
+	{
+		bulletinStats.sent++;
+		if (late >= 60)
+		{
+			bulletinStats.late++;
+		}
+	}
+	preparedText[0] = '\0';
+	dueLocal[i] = 0;
+}
+
+/**
+ * @brief Sends bulletins that have come due. Called every loop() pass.
+ *
+ * Sets up the schedule once the clock is set, then costs a few compares
+ * per pass; the times themselves are watched by an ezTime event, so events()
+ * must also be called from loop(). The next aphorism is picked while no
+ * bulletin is waiting.
+ */
+void processBulletins()
+{
+	if (!scheduled)
+	{
+		if (timeStatus() != timeSet)
+		{
+			return;
+		}
+		time_t now = myTZ.now();
+		for (int i = 0; i < APRS_BULLETIN_COUNT; i++)
+		{
+			nextLocal[i] = nextOccurrence(APRS_BULLETIN_SCHEDULE[i], now);
+			dueLocal[i] = 0;
+		}
+		armBulletinEvent();
+		scheduled = true;
+	}
+
+	bool waiting = false;
+	for (int i = 0; i < APRS_BULLETIN_COUNT; i++)
+	{
+		if (dueLocal[i] != 0)
+		{
+			sendDueBulletin(i);
+			waiting = waiting || dueLocal[i] != 0;
+		}
+	}
+
+	if (!waiting && preparedText[0] == '\0')
+	{
+		prepareBulletinText(false);
+	}
+}
+
+// End of file
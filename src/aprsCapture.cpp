@@ -0,0 +1,186 @@
+/**
+ * @file aprsCapture.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of APRS-IS stream capture and replay.
+ *
+ * The capture file stays open while recording and is flushed every
+ * APRS_CAPTURE_FLUSH_LINES lines, so a reset loses at most that many. The
+ * capture stops by itself at APRS_CAPTURE_MAX_BYTES to protect the aphorism
+ * file's share of flash.
+ *
+ * A replay ends by itself at the end of the file; updateAPRS() then goes back
+ * to the live server.
+ */
+
+#include "aprsCapture.h"
+
+#include <Arduino.h>	  // Arduino functions
+#include <LittleFS.h>	  // capture files
+#include "aprsReplay.h"	  // APRSReplaySource
+#include "wug_debug.h"	  // debug print macro
+
+static File captureFile;			  // open while capturing
+static unsigned long captureBytes = 0; // bytes in captureFile
+static int captureUnflushed = 0;	  // lines since the last flush
+
+static File replayFile;									// open while replaying
+static APRSReplaySource<File> *replaySource = nullptr; // reads replayFile
+
+/**
+ * @brief Starts recording received lines.
+ *
+ * An existing capture at path is replaced: its stamps are millis() from an
+ * earlier boot and would not follow on from the new ones.
+ *
+ * @param path LittleFS file name.
+ * @return true if the file was opened.
+ */
+bool startAPRSCapture(const char *path)
+{
+	stopAPRSCapture();
+	captureFile = LittleFS.open(path, "w");
+	if (!captureFile)
+	{
+		DEBUG_PRINTLN(F("APRS capture: cannot open file"));
+		return false;
+	}
+	captureBytes = captureFile.size();
+	captureUnflushed = 0;
+	DEBUG_PRINT(F("APRS capture to "));
+	DEBUG_PRINTLN(path);
+	return true;
+}
+
+//! Stops recording and closes the capture file.
+void stopAPRSCapture()
+{
+	if (captureFile)
+	{
+		captureFile.close();
+	}
+}
+
+/**
+ * @brief Appends one received line to the capture, if one is running.
+ *
+ * @param line A line as returned by the line reader.
+ */
+void captureAPRSLine(const APRSLine &line)
+{
+	if (!captureFile)
+	{
+		return;
+	}
+
+	char stamp[12];
+	int stampLength = snprintf(stamp, sizeof(stamp), "%lu\t", millis());
+	if (captureBytes + stampLength + line.length + 1 > APRS_CAPTURE_MAX_BYTES)
+	{
+		DEBUG_PRINTLN(F("APRS capture full"));
+		stopAPRSCapture();
+		return;
+	}
+
+	captureFile.write((const uint8_t *)stamp, stampLength);
+	captureFile.write((const uint8_t *)line.text, line.length);
+	captureFile.write('\n');
+	captureBytes += stampLength + line.length + 1;
+
+	if (++captureUnflushed >= APRS_CAPTURE_FLUSH_LINES)
+	{
+		captureFile.flush();
+		captureUnflushed = 0;
+	}
+}
+
+/**
+ * @brief Starts feeding a capture to readAPRSPacket() in place of the server.
+ *
+ * @param path     LittleFS file written by a capture.
+ * @param realTime true to keep the recorded spacing, false to go as fast as possible.
+ * @return true if the file was opened.
+ */
+bool startAPRSReplay(const char *path, bool realTime)
+{
+	stopAPRSReplay();
+	replayFile = LittleFS.open(path, "r");
+	if (!replayFile)
+	{
+		DEBUG_PRINTLN(F("APRS replay: cannot open file"));
+		return false;
+	}
+	replaySource = new APRSReplaySource<File>(replayFile, millis, realTime);
+	DEBUG_PRINT(F("APRS replay from "));
+	DEBUG_PRINTLN(path);
+	return true;
+}
+
+//! Ends a replay and closes its file.
+void stopAPRSReplay()
+{
+	if (replaySource != nullptr)
+	{
+		DEBUG_PRINT(F("APRS replay done, lines: "));
+		DEBUG_PRINT(replaySource->records());
+		DEBUG_PRINT(F(" bad records: "));
+		DEBUG_PRINTLN(replaySource->badRecords());
+		delete replaySource;
+		replaySource = nullptr;
+	}
+	if (replayFile)
+	{
+		replayFile.close();
+	}
+}
+
+//! True while a replay is feeding the receive path.
+bool aprsReplayActive()
+{
+	return replaySource != nullptr;
+}
+
+/**
+ * @brief Reads the next replayed line through the receive buffer.
+ *
+ * Stops the replay when the capture is used up.
+ *
+ * @return true if a line was returned in line.
+ */
+bool readAPRSReplay(APRSLineReader &reader, APRSLine &line)
+{
+	if (replaySource == nullptr)
+	{
+		return false;
+	}
+	if (reader.readLine(*replaySource, line))
+	{
+		return true;
+	}
+	if (replaySource->finished())
+	{
+		stopAPRSReplay();
+	}
+	return false;
+}
+
+/**
+ * @brief Starts the capture or replay selected at build time, if any.
+ *
+ * Called from setup() once LittleFS is mounted.
+ */
+void beginAPRSCapture()
+{
+#ifdef APRS_CAPTURE_FILE
+	startAPRSCapture(APRS_CAPTURE_FILE);
+#endif
+#ifdef APRS_REPLAY_FILE
+#ifdef APRS_REPLAY_FAST
+	startAPRSReplay(APRS_REPLAY_FILE, false);
+#else
+	startAPRSReplay(APRS_REPLAY_FILE, true);
+#endif
+#endif
+}
+
+// End of file
@@ -0,0 +1,113 @@
+/**
+ * @file aprsDedupe.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the retried-message suppression table.
+ *
+ * Keys are 32-bit FNV-1a hashes of the source callsign and message ID. A hash
+ * collision can at worst make a new query look like a retry, which costs one
+ * reply, so the full strings are not stored.
+ */
+
+#include "aprsDedupe.h"
+
+static_assert((APRS_DEDUPE_SLOTS & (APRS_DEDUPE_SLOTS - 1)) == 0, "APRS_DEDUPE_SLOTS must be a power of two");
+static_assert(APRS_DEDUPE_PROBES <= APRS_DEDUPE_SLOTS, "APRS_DEDUPE_PROBES exceeds the table");
+
+static const uint32_t FNV_OFFSET = 2166136261UL;
+static const uint32_t FNV_PRIME = 16777619UL;
+
+//! Continues an FNV-1a hash over a field.
+static uint32_t fnv1a(uint32_t hash, const APRSField &field)
+{
+	for (uint16_t i = 0; i < field.length; i++)
+	{
+		hash ^= (uint8_t)field.text[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+APRSDedupeTable::APRSDedupeTable(unsigned long ttlMs)
+	: _ttlMs(ttlMs), _hits(0), _misses(0), _evictions(0)
+{
+	clear();
+}
+
+//! Forgets all remembered messages. Counters are kept.
+void APRSDedupeTable::clear()
+{
+	for (int i = 0; i < APRS_DEDUPE_SLOTS; i++)
+	{
+		_slots[i].key = 0;
+		_slots[i].stamp = 0;
+	}
+}
+
+uint32_t APRSDedupeTable::hashKey(const APRSField &source, const APRSField &msgID)
+{
+	uint32_t hash = fnv1a(FNV_OFFSET, source);
+	hash ^= '{'; // separator so "AB"+"1" and "A"+"B1" differ
+	hash *= FNV_PRIME;
+	hash = fnv1a(hash, msgID);
+	return hash ? hash : 1; // 0 is reserved for empty slots
+}
+
+bool APRSDedupeTable::expired(const Slot &slot, unsigned long now) const
+{
+	return slot.key == 0 || (uint32_t)(now - slot.stamp) >= _ttlMs;
+}
+
+/**
+ * @brief Checks a message against the table and remembers it.
+ *
+ * A hit refreshes the entry, so a station that keeps retrying stays
+ * suppressed until it has been quiet for the TTL.
+ *
+ * @param source Sending station.
+ * @param msgID  Message ID from the {ID} suffix.
+ * @param now    Current millis().
+ * @return true if the same source and ID were seen within the TTL.
+ */
+bool APRSDedupeTable::seen(const APRSField &source, const APRSField &msgID, unsigned long now)
+{
+	uint32_t key = hashKey(source, msgID);
+	int start = key & (APRS_DEDUPE_SLOTS - 1);
+	Slot *freeSlot = nullptr;
+	Slot *oldest = nullptr;
+
+	for (int i = 0; i < APRS_DEDUPE_PROBES; i++)
+	{
+		Slot &slot = _slots[(start + i) & (APRS_DEDUPE_SLOTS - 1)];
+		if (expired(slot, now))
+		{
+			if (freeSlot == nullptr)
+			{
+				freeSlot = &slot;
+			}
+			continue;
+		}
+		if (slot.key == key)
+		{
+			slot.stamp = now;
+			_hits++;
+			return true;
+		}
+		if (oldest == nullptr || (uint32_t)(now - slot.stamp) > (uint32_t)(now - oldest->stamp))
+		{
+			oldest = &slot;
+		}
+	}
+
+	_misses++;
+	if (freeSlot == nullptr)
+	{
+		freeSlot = oldest;
+		_evictions++;
+	}
+	freeSlot->key = key;
+	freeSlot->stamp = now;
+	return false;
+}
+
+// End of file
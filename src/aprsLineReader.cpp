@@ -0,0 +1,149 @@
+/**
+ * @file aprsLineReader.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the fixed-buffer APRS-IS line reader.
+ *
+ * The buffer holds received bytes between _tail and _head. Lines are framed in
+ * place: the LF (and a preceding CR) is overwritten with a null terminator and
+ * the caller gets a view of the line. Consumed space at the front is reclaimed
+ * by compact() only when no complete line is left, so each byte is moved at
+ * most once per line on a busy feed.
+ *
+ * One byte of the buffer is always kept free so a truncated line can still be
+ * null-terminated.
+ */
+
+#include "aprsLineReader.h"
+
+#include <string.h> // memchr, memmove
+
+static const size_t LINE_CAPACITY = APRS_BUFFER_SIZE - 1; // room for the null terminator
+
+APRSLineReader::APRSLineReader()
+	: _linesRead(0), _truncatedLines(0), _bytesRead(0)
+{
+	reset();
+}
+
+/**
+ * @brief Discards all buffered bytes.
+ *
+ * Call when a new connection is made so a partial line from the old session
+ * is not joined to the first line of the new one. Counters are kept.
+ */
+void APRSLineReader::reset()
+{
+	_tail = 0;
+	_scan = 0;
+	_head = 0;
+	_discarding = false;
+	_buf[0] = '\0';
+}
+
+/**
+ * @brief Frames the next complete line from bytes already in the buffer.
+ *
+ * Blank lines are skipped. If the buffer fills without a line terminator the
+ * buffered part is returned with truncated set and the rest of that line is
+ * dropped as it arrives.
+ *
+ * @param line Receives the view of the line.
+ * @return true if a line was framed.
+ */
+bool APRSLineReader::nextLine(APRSLine &line)
+{
+	while (_scan < _head)
+	{
+		char *nl = (char *)memchr(_buf + _scan, '\n', _head - _scan);
+		if (nl == nullptr)
+		{
+			_scan = _head;
+			break;
+		}
+
+		size_t start = _tail;
+		size_t end = nl - _buf;
+		_tail = end + 1;
+		_scan = _tail;
+
+		if (_discarding)
+		{
+			_discarding = false; // end of an oversized line, already reported
+			continue;
+		}
+		if (end > start && _buf[end - 1] == '\r')
+		{
+			end--;
+		}
+		if (end == start)
+		{
+			continue; // blank line
+		}
+
+		_buf[end] = '\0';
+		line.text = _buf + start;
+		line.length = end - start;
+		line.truncated = false;
+		_linesRead++;
+		return true;
+	}
+
+	// buffer full and no terminator in sight
+	if (_tail == 0 && _head >= LINE_CAPACITY)
+	{
+		bool report = !_discarding;
+		_tail = _scan = _head; // consumed; reclaimed by the next compact()
+		_discarding = true;
+		if (!report)
+		{
+			return false; // still inside a line that was already reported
+		}
+		_buf[_head] = '\0';
+		line.text = _buf;
+		line.length = _head;
+		line.truncated = true;
+		_truncatedLines++;
+		_linesRead++;
+		return true;
+	}
+	return false;
+}
+
+//! Where the next received bytes are to be written.
+char *APRSLineReader::fillPointer()
+{
+	return _buf + _head;
+}
+
+//! Number of bytes that may be written at fillPointer().
+size_t APRSLineReader::spaceLeft() const
+{
+	return LINE_CAPACITY - _head;
+}
+
+//! Records that count bytes were written at fillPointer().
+void APRSLineReader::commit(size_t count)
+{
+	_head += count;
+	_bytesRead += count;
+}
+
+//! Moves any partial line to the front of the buffer.
+void APRSLineReader::compact()
+{
+	if (_tail == 0)
+	{
+		return;
+	}
+	size_t pending = _head - _tail;
+	if (pending > 0)
+	{
+		memmove(_buf, _buf + _tail, pending);
+	}
+	_head = pending;
+	_scan -= _tail;
+	_tail = 0;
+}
+
+// End of file
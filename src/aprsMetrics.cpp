@@ -0,0 +1,117 @@
+/**
+ * @file aprsMetrics.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the APRS metrics module.
+ */
+
+#include "aprsMetrics.h"
+
+#include <Arduino.h>	   // Arduino functions
+#include "aprsResponder.h" // responderStats
+#include "aprsService.h"   // receive, transmit and session counters
+
+static unsigned long counters[METRIC_COUNTER_COUNT];
+static MetricTiming timings[METRIC_TIMER_COUNT];
+
+static const char *const TIMER_NAMES[METRIC_TIMER_COUNT] = {
+	"pollAPRS",
+	"updateAPRS",
+	"pickAphorism",
+};
+
+static const char *const COUNTER_NAMES[METRIC_COUNTER_COUNT] = {
+	"connect failed",
+	"logon verified",
+	"logon unverified",
+	"logon timeout",
+};
+
+//! Counts one event.
+void metricsCount(MetricCounter counter)
+{
+	counters[counter]++;
+}
+
+//! Adds one timing sample.
+void metricsRecord(MetricTimer timer, unsigned long elapsedUs)
+{
+	MetricTiming &t = timings[timer];
+	if (t.count == 0 || elapsedUs < t.minUs)
+	{
+		t.minUs = elapsedUs;
+	}
+	if (elapsedUs > t.maxUs)
+	{
+		t.maxUs = elapsedUs;
+	}
+	t.totalUs += elapsedUs;
+	t.count++;
+}
+
+/**
+ * @brief Copies all metrics into a snapshot.
+ *
+ * Cheap enough to call from loop(): it only copies counters.
+ *
+ * @param snapshot Receives the current values.
+ */
+void getAPRSMetrics(APRSMetricsSnapshot &snapshot)
+{
+	snapshot.uptimeMs = millis();
+
+	snapshot.packetsIn = aprsReader.linesRead();
+	snapshot.bytesIn = aprsReader.bytesRead();
+	snapshot.truncated = aprsReader.truncatedLines();
+	snapshot.fastRejected = aprsFastRejected;
+	snapshot.parsed = aprsPacketsParsed;
+	snapshot.parseErrors = aprsParseErrors;
+
+	const APRSTxStats &tx = aprsTx.stats();
+	snapshot.packetsOut = tx.sent;
+	snapshot.bytesOut = tx.bytesSent;
+	snapshot.segments = tx.segments;
+	snapshot.txDrops = tx.dropped;
+	snapshot.replyDrops = responderStats.dropped;
+	snapshot.txDepth = aprsTx.depth();
+
+	snapshot.reconnects = aprsSessions.reconnects;
+	memcpy(snapshot.counters, counters, sizeof(counters));
+	memcpy(snapshot.timing, timings, sizeof(timings));
+}
+
+/**
+ * @brief Prints a metrics snapshot as name: value lines.
+ *
+ * @param out Where to print, e.g. Serial.
+ */
+void printAPRSMetrics(Print &out)
+{
+	APRSMetricsSnapshot snap;
+	getAPRSMetrics(snap);
+
+	out.printf("APRS metrics at %lu s\n", snap.uptimeMs / 1000);
+	out.printf("  in: %lu packets %lu bytes, %lu rejected, %lu parsed, %lu errors, %lu truncated\n",
+			   snap.packetsIn, snap.bytesIn, snap.fastRejected, snap.parsed, snap.parseErrors, snap.truncated);
+	out.printf("  out: %lu packets %lu bytes %lu segments, %lu tx drops, %lu reply drops, depth %d\n",
+			   snap.packetsOut, snap.bytesOut, snap.segments, snap.txDrops, snap.replyDrops, snap.txDepth);
+	out.printf("  reconnects: %lu\n", snap.reconnects);
+	for (int i = 0; i < METRIC_COUNTER_COUNT; i++)
+	{
+		out.printf("  %s: %lu\n", COUNTER_NAMES[i], snap.counters[i]);
+	}
+	for (int i = 0; i < METRIC_TIMER_COUNT; i++)
+	{
+		const MetricTiming &t = snap.timing[i];
+		out.printf("  %s us: min %lu avg %lu max %lu (%lu calls)\n",
+				   TIMER_NAMES[i], t.minUs, t.avgUs(), t.maxUs, t.count);
+	}
+}
+
+//! Scheduled task: prints the metrics to the serial port.
+void reportAPRSMetrics()
+{
+	printAPRSMetrics(Serial);
+}
+
+// End of file
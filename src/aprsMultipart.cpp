@@ -0,0 +1,250 @@
+/**
+ * @file aprsMultipart.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of multi-part APRS messages and bulletins.
+ *
+ * Bulletin parts keep the bulletin ID and are told apart by their marker;
+ * message parts carry no message ID, like single-part replies, so no acks
+ * are expected for them.
+ */
+
+#include "aprsMultipart.h"
+
+#include <Arduino.h>	 // millis()
+#include "aprsParser.h"	 // APRS_MESSAGE_MAX, APRS_ADDRESSEE_WIDTH
+#include "aprsService.h" // APRSbuildMessage(), APRSbuildBulletin(), postToAPRS()
+#include "wug_debug.h"	 // debug print macro
+
+static_assert(APRS_MULTIPART_TEXT_MAX <= 255, "part offsets are 8 bits");
+
+struct PendingText
+{
+	APRSMultipartKind kind;
+	char to[APRS_ADDRESSEE_WIDTH + 1];		 // recipient or bulletin ID
+	char text[APRS_MULTIPART_TEXT_MAX + 1];
+	APRSTextPart parts[APRS_MULTIPART_PARTS_MAX];
+	uint8_t partCount;						 // 0 if the slot is free
+	uint8_t nextPart;						 // next part to send
+	unsigned long dueMs;					 // millis() when it may be sent
+};
+
+APRSMultipartStats multipartStats;
+
+static PendingText pending[APRS_MULTIPART_QUEUE_SIZE];
+
+/**
+ * @brief Splits text into parts that fit one APRS message each.
+ *
+ * Breaks at the last space that fits, so words stay whole unless a single
+ * word is longer than a part. Spaces at the breaks are dropped.
+ *
+ * @param text     Text to split, need not be null-terminated.
+ * @param length   Characters in text, at most APRS_MULTIPART_TEXT_MAX.
+ * @param parts    Receives the parts.
+ * @param maxParts Room in parts, at most APRS_MULTIPART_PARTS_MAX counts.
+ * @return Number of parts, 1 if the text fits as it is, 0 if it is empty,
+ *         too long or needs more than maxParts parts.
+ */
+int splitAPRSText(const char *text, size_t length, APRSTextPart *parts, int maxParts)
+{
+	while (length > 0 && text[length - 1] == ' ')
+	{
+		length--;
+	}
+	size_t start = 0;
+	while (start < length && text[start] == ' ')
+	{
+		start++;
+	}
+	if (start == length || length > (size_t)APRS_MULTIPART_TEXT_MAX || maxParts < 1)
+	{
+		return 0;
+	}
+	if (length - start <= (size_t)APRS_MESSAGE_MAX)
+	{
+		parts[0].offset = (uint8_t)start;
+		parts[0].length = (uint8_t)(length - start);
+		return 1;
+	}
+
+	if (maxParts > APRS_MULTIPART_PARTS_MAX)
+	{
+		maxParts = APRS_MULTIPART_PARTS_MAX;
+	}
+	const size_t room = APRS_MESSAGE_MAX - APRS_MULTIPART_MARKER;
+	int count = 0;
+	while (start < length)
+	{
+		if (count == maxParts)
+		{
+			return 0;
+		}
+		size_t end = length;
+		if (end - start > room)
+		{
+			end = start + room;
+			size_t space = end;
+			while (space > start && text[space] != ' ')
+			{
+				space--;
+			}
+			if (space > start)
+			{
+				end = space; // break at the space, else cut the word
+			}
+		}
+		size_t last = end;
+		while (last > start && text[last - 1] == ' ')
+		{
+			last--;
+		}
+		parts[count].offset = (uint8_t)start;
+		parts[count].length = (uint8_t)(last - start);
+		count++;
+
+		start = end;
+		while (start < length && text[start] == ' ')
+		{
+			start++;
+		}
+	}
+	return count;
+}
+
+//! Builds and queues part k of slot p for the transmit path.
+static void sendPart(PendingText &p, int k)
+{
+	char body[APRS_MESSAGE_MAX + 1];
+	size_t length = 0;
+	if (p.partCount > 1)
+	{
+		body[length++] = (char)('1' + k);
+		body[length++] = '/';
+		body[length++] = (char)('0' + p.partCount);
+		body[length++] = ' ';
+	}
+	memcpy(body + length, p.text + p.parts[k].offset, p.parts[k].length);
+	length += p.parts[k].length;
+	body[length] = '\0';
+
+	APRSPacketBuilder packet;
+	bool built = (p.kind == MULTIPART_BULLETIN) ? APRSbuildBulletin(packet, body, p.to)
+												 : APRSbuildMessage(packet, p.to, body);
+	if (built)
+	{
+		postToAPRS(packet.c_str(), packet.length());
+		multipartStats.parts++;
+	}
+}
+
+//! True if sendAPRSText() can take a text that needs more than one part.
+bool aprsMultipartSlotFree()
+{
+	for (int i = 0; i < APRS_MULTIPART_QUEUE_SIZE; i++)
+	{
+		if (pending[i].partCount == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Sends a text as a message or bulletin, in parts if it is too long.
+ *
+ * The first part is queued for transmission at once; the rest follow from
+ * serviceAPRSMultipart(), APRS_MULTIPART_SPACING apart.
+ *
+ * @param kind   Message to a callsign or bulletin.
+ * @param to     Recipient callsign, or the bulletin ID.
+ * @param text   Text to send, need not be null-terminated.
+ * @param length Characters in text.
+ * @return false if the text cannot be split or no queue slot is free.
+ */
+bool sendAPRSText(APRSMultipartKind kind, const char *to, const char *text, size_t length)
+{
+	PendingText *slot = nullptr;
+	for (int i = 0; i < APRS_MULTIPART_QUEUE_SIZE && slot == nullptr; i++)
+	{
+		if (pending[i].partCount == 0)
+		{
+			slot = &pending[i];
+		}
+	}
+	PendingText single; // a text that fits needs no slot
+	PendingText &p = (slot != nullptr) ? *slot : single;
+
+	int count = splitAPRSText(text, length, p.parts, APRS_MULTIPART_PARTS_MAX);
+	if (length > (size_t)APRS_MULTIPART_TEXT_MAX)
+	{
+		count = 0;
+	}
+	if (count == 0 || (count > 1 && slot == nullptr) || strlen(to) > (size_t)APRS_ADDRESSEE_WIDTH)
+	{
+		DEBUG_PRINTLN(F("APRS text not sent, too long or too many pending"));
+		multipartStats.refused++;
+		return false;
+	}
+
+	p.kind = kind;
+	strcpy(p.to, to);
+	memcpy(p.text, text, length);
+	p.text[length] = '\0';
+	p.partCount = (uint8_t)count;
+	sendPart(p, 0);
+
+	multipartStats.texts++;
+	if (count == 1)
+	{
+		p.partCount = 0; // slot stays free
+		return true;
+	}
+	multipartStats.split++;
+	p.nextPart = 1;
+	p.dueMs = millis() + APRS_MULTIPART_SPACING;
+	return true;
+}
+
+/**
+ * @brief Sends the next part of each pending text whose time has come.
+ *
+ * Called every pollAPRS() pass.
+ */
+void serviceAPRSMultipart()
+{
+	unsigned long now = millis();
+	for (int i = 0; i < APRS_MULTIPART_QUEUE_SIZE; i++)
+	{
+		PendingText &p = pending[i];
+		if (p.partCount == 0 || (long)(now - p.dueMs) < 0)
+		{
+			continue;
+		}
+		sendPart(p, p.nextPart++);
+		if (p.nextPart == p.partCount)
+		{
+			p.partCount = 0;
+		}
+		else
+		{
+			p.dueMs = now + APRS_MULTIPART_SPACING;
+		}
+	}
+}
+
+//! Drops pending parts, e.g. when the connection is lost.
+void clearAPRSMultipart()
+{
+	for (int i = 0; i < APRS_MULTIPART_QUEUE_SIZE; i++)
+	{
+		if (pending[i].partCount != 0)
+		{
+			multipartStats.dropped += pending[i].partCount - pending[i].nextPart;
+			pending[i].partCount = 0;
+		}
+	}
+}
+
+// End of file
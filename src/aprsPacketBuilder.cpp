@@ -0,0 +1,194 @@
+/**
+ * @file aprsPacketBuilder.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the fixed-buffer APRS packet builder.
+ *
+ * Field layouts follow APRS101.pdf: callsigns pg 12, messages, acks and
+ * bulletins pg 71 and 83, positions pg 23.
+ */
+
+#include "aprsPacketBuilder.h"
+
+#include <stdio.h>		// snprintf
+#include <string.h>		// memcpy, strlen
+#include "aprsParser.h" // field widths
+
+APRSPacketBuilder::APRSPacketBuilder()
+{
+	reset();
+}
+
+void APRSPacketBuilder::reset()
+{
+	_buf[0] = '\0';
+	_length = 0;
+	_failed = false;
+}
+
+//! Marks the packet failed; always returns false.
+bool APRSPacketBuilder::fail()
+{
+	_failed = true;
+	return false;
+}
+
+bool APRSPacketBuilder::append(char c)
+{
+	return append(&c, 1);
+}
+
+bool APRSPacketBuilder::append(const char *text)
+{
+	return append(text, strlen(text));
+}
+
+/**
+ * @brief Appends length characters of text.
+ *
+ * @return false, and the packet is failed, if they do not all fit.
+ */
+bool APRSPacketBuilder::append(const char *text, size_t length)
+{
+	if (_failed || length > (size_t)APRS_PACKET_SIZE - _length)
+	{
+		return fail();
+	}
+	memcpy(_buf + _length, text, length);
+	_length += length;
+	_buf[_length] = '\0';
+	return true;
+}
+
+/**
+ * @brief Appends text left-justified in a field of width characters.
+ *
+ * Shorter text is filled with spaces, longer text is cut, as "%-9.9s" does.
+ */
+bool APRSPacketBuilder::appendPadded(const char *text, size_t width)
+{
+	if (_failed || width > (size_t)APRS_PACKET_SIZE - _length)
+	{
+		return fail();
+	}
+	size_t length = strnlen(text, width);
+	memcpy(_buf + _length, text, length);
+	memset(_buf + _length + length, ' ', width - length);
+	_length += width;
+	_buf[_length] = '\0';
+	return true;
+}
+
+/**
+ * @brief Appends a number with leading zeros to exactly width characters.
+ *
+ * @return false, and the packet is failed, if the number needs more than
+ *         width characters, since APRS weather and telemetry fields are fixed.
+ */
+bool APRSPacketBuilder::appendZeroPadded(long value, int width)
+{
+	char digits[24];
+	int length = snprintf(digits, sizeof(digits), "%0*ld", width, value);
+	if (length < 0 || length > width)
+	{
+		return fail();
+	}
+	return append(digits, (size_t)length);
+}
+
+/**
+ * @brief Appends a position as DDmm.mmN/DDDmm.mmW.
+ *
+ * Latitude and longitude in decimal degrees are clamped to their ranges.
+ * The '/' between them selects the primary symbol table.
+ */
+bool APRSPacketBuilder::appendLocation(float lat, float lon)
+{
+	lat = (lat < -90) ? -90 : (lat > 90) ? 90 : lat;
+	lon = (lon < -180) ? -180 : (lon > 180) ? 180 : lon;
+
+	char latID = (lat < 0) ? 'S' : 'N';
+	char lonID = (lon < 0) ? 'W' : 'E';
+	lat = (lat < 0) ? -lat : lat;
+	lon = (lon < 0) ? -lon : lon;
+	unsigned latDeg = (unsigned)lat;	// degrees
+	float latMin = 60 * (lat - latDeg); // minutes
+	unsigned lonDeg = (unsigned)lon;
+	float lonMin = 60 * (lon - lonDeg);
+
+	char buf[24];
+	int length = snprintf(buf, sizeof(buf), "%02u%05.2f%c/%03u%05.2f%c",
+						  latDeg, latMin, latID, lonDeg, lonMin, lonID);
+	if (length < 0 || length >= (int)sizeof(buf))
+	{
+		return fail();
+	}
+	return append(buf, (size_t)length);
+}
+
+/**
+ * @brief Starts a packet from source over APRS-IS: SOURCE>APRS,TCPIP*:
+ *
+ * @param source Callsign with optional SSID, at most APRS_CALLSIGN_MAX characters.
+ */
+bool APRSPacketBuilder::header(const char *source)
+{
+	size_t length = strlen(source);
+	if (length == 0 || length > (size_t)APRS_CALLSIGN_MAX)
+	{
+		return fail();
+	}
+	return append(source, length) && append(">APRS,TCPIP*:");
+}
+
+/**
+ * @brief Appends a message addressee field, :ADDRESSEE:, padded to 9 characters.
+ *
+ * @param addressee Callsign or bulletin name, at most APRS_ADDRESSEE_WIDTH characters.
+ */
+bool APRSPacketBuilder::appendAddressee(const char *addressee)
+{
+	size_t length = strlen(addressee);
+	if (length == 0 || length > (size_t)APRS_ADDRESSEE_WIDTH)
+	{
+		return fail();
+	}
+	return append(APRS_ID_MESSAGE) && appendPadded(addressee, APRS_ADDRESSEE_WIDTH) && append(APRS_ID_MESSAGE);
+}
+
+bool APRSPacketBuilder::appendMessageText(const char *text)
+{
+	return appendMessageText(text, strlen(text));
+}
+
+/**
+ * @brief Appends message or bulletin text.
+ *
+ * @return false, and the packet is failed, if the text is longer than
+ *         APRS_MESSAGE_MAX characters.
+ */
+bool APRSPacketBuilder::appendMessageText(const char *text, size_t length)
+{
+	if (length > (size_t)APRS_MESSAGE_MAX)
+	{
+		return fail();
+	}
+	return append(text, length);
+}
+
+/**
+ * @brief Appends a message ID, {ID, for a message that expects an ack.
+ *
+ * @param id One to APRS_MSG_ID_MAX characters.
+ */
+bool APRSPacketBuilder::appendMessageId(const char *id)
+{
+	size_t length = strlen(id);
+	if (length == 0 || length > (size_t)APRS_MSG_ID_MAX)
+	{
+		return fail();
+	}
+	return append('{') && append(id, length);
+}
+
+// End of file
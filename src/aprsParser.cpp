@@ -0,0 +1,210 @@
+/**
+ * @file aprsParser.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the single-pass TNC2 packet parser.
+ *
+ * The header is walked once from left to right: the source ends at '>', the
+ * destination at the first ',' or ':', and the path at the first ':'. The
+ * payload is whatever follows. Message payloads are split further:
+ *
+ *  ___________________________________
+ *  |:| Addressee |:| Text   |{| ID   |
+ *  |1|     9     |1| 0-67   |1| 1-5  |
+ *  |_|___________|_|________|_|______|
+ *
+ * APRS101.pdf pg 71. A reply-ack ID of the form {MM}AA yields MM as the ID.
+ */
+
+#include "aprsParser.h"
+
+#include <string.h> // memchr, memcmp, strlen
+
+//! Fills a field view from a begin/end pair.
+static void setField(APRSField &field, const char *begin, const char *end)
+{
+	field.text = begin;
+	field.length = (uint16_t)(end - begin);
+}
+
+bool APRSField::equals(const char *str) const
+{
+	size_t len = strlen(str);
+	return len == length && memcmp(text, str, len) == 0;
+}
+
+/**
+ * @brief Maps an APRS data type identifier to a payload class.
+ *
+ * @param dataType First character of the payload.
+ * @return The payload class, APRS_TYPE_OTHER if the identifier is not handled.
+ */
+APRSPacketType aprsClassify(char dataType)
+{
+	switch (dataType)
+	{
+	case APRS_ID_POSITION_NO_TIMESTAMP:
+		return APRS_TYPE_POSITION;
+	case APRS_ID_TELEMETRY:
+		return APRS_TYPE_TELEMETRY;
+	case APRS_ID_WEATHER:
+		return APRS_TYPE_WEATHER;
+	case APRS_ID_MESSAGE:
+		return APRS_TYPE_MESSAGE;
+	case APRS_ID_QUERY:
+		return APRS_TYPE_QUERY;
+	case APRS_ID_STATUS:
+		return APRS_TYPE_STATUS;
+	case APRS_ID_USER_DEF:
+		return APRS_TYPE_USER_DEF;
+	case APRS_ID_COMMENT:
+		return APRS_TYPE_COMMENT;
+	default:
+		return APRS_TYPE_OTHER;
+	}
+}
+
+/**
+ * @brief Splits the message fields out of a ':' payload.
+ *
+ * @return false if the payload does not have a valid addressee field.
+ */
+static bool parseMessage(const char *p, const char *end, APRSPacket &packet)
+{
+	// ':' + 9 character addressee + ':'
+	if (end - p < APRS_ADDRESSEE_WIDTH + 2 || p[APRS_ADDRESSEE_WIDTH + 1] != ':')
+	{
+		return false;
+	}
+	const char *addr = p + 1;
+	const char *addrEnd = addr + APRS_ADDRESSEE_WIDTH;
+	while (addrEnd > addr && addrEnd[-1] == ' ')
+	{
+		addrEnd--;
+	}
+	if (addrEnd == addr)
+	{
+		return false;
+	}
+	setField(packet.addressee, addr, addrEnd);
+
+	const char *text = addr + APRS_ADDRESSEE_WIDTH + 1;
+	const char *brace = (const char *)memchr(text, '{', end - text);
+	if (brace == nullptr)
+	{
+		setField(packet.text, text, end);
+		setField(packet.msgID, end, end);
+		return true;
+	}
+	setField(packet.text, text, brace);
+
+	const char *id = brace + 1;
+	const char *idEnd = id;
+	while (idEnd < end && *idEnd != '}' && idEnd - id < APRS_MSG_ID_MAX)
+	{
+		idEnd++;
+	}
+	setField(packet.msgID, id, idEnd);
+	return true;
+}
+
+/**
+ * @brief Parses one TNC2-format packet line in a single pass.
+ *
+ * @param line   Packet text, need not be null-terminated.
+ * @param length Number of characters in line.
+ * @param packet Receives views into line.
+ * @return true if the header is well formed (and, for messages, the addressee field).
+ */
+bool parseAPRSPacket(const char *line, size_t length, APRSPacket &packet)
+{
+	const char *p = line;
+	const char *end = line + length;
+
+	packet.addressee = APRSField();
+	packet.text = APRSField();
+	packet.msgID = APRSField();
+
+	// SRC>
+	const char *src = p;
+	while (p < end && *p != '>' && *p != ':' && *p != ',')
+	{
+		p++;
+	}
+	if (p == end || *p != '>' || p == src)
+	{
+		return false;
+	}
+	setField(packet.source, src, p);
+
+	// DST, or DST:
+	const char *dst = ++p;
+	while (p < end && *p != ',' && *p != ':')
+	{
+		p++;
+	}
+	if (p == end || p == dst)
+	{
+		return false;
+	}
+	setField(packet.destination, dst, p);
+
+	// PATH:
+	const char *path = p;
+	if (*p == ',')
+	{
+		path = ++p;
+		while (p < end && *p != ':')
+		{
+			p++;
+		}
+		if (p == end)
+		{
+			return false;
+		}
+	}
+	setField(packet.path, path, p);
+
+	// payload
+	p++;
+	setField(packet.payload, p, end);
+	packet.dataType = (p < end) ? *p : 0;
+	packet.type = aprsClassify(packet.dataType);
+
+	if (packet.type == APRS_TYPE_MESSAGE)
+	{
+		return parseMessage(p, end, packet);
+	}
+	return true;
+}
+
+/**
+ * @brief Fast check whether a packet line is a message to a given station.
+ *
+ * Looks only at the ::ADDRESSEE: field right after the header so packets for
+ * other stations can be dropped before the full parse. No other validation is
+ * done; a line that passes still has to go through parseAPRSPacket().
+ *
+ * @param line       Packet text, need not be null-terminated.
+ * @param length     Number of characters in line.
+ * @param paddedCall Station callsign padded with spaces to APRS_ADDRESSEE_WIDTH,
+ *                   as produced by APRSpadCall().
+ * @return true if the addressee field matches paddedCall exactly.
+ */
+bool aprsIsAddressedTo(const char *line, size_t length, const char *paddedCall)
+{
+	// the header holds no ':' so the first one starts the payload
+	const char *colon = (const char *)memchr(line, ':', length);
+	if (colon == nullptr)
+	{
+		return false;
+	}
+	const char *payload = colon + 1;
+	size_t left = length - (payload - line);
+	return left >= (size_t)APRS_ADDRESSEE_WIDTH + 2 &&
+		   payload[0] == APRS_ID_MESSAGE &&
+		   payload[APRS_ADDRESSEE_WIDTH + 1] == ':' &&
+		   memcmp(payload + 1, paddedCall, APRS_ADDRESSEE_WIDTH) == 0;
+}
+
+// End of file
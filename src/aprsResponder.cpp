@@ -0,0 +1,175 @@
+/**
+ * @file aprsResponder.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the APRS query responder.
+ *
+ * Queries are copied out of the receive buffer into a small fixed queue so the
+ * reader can keep going, then answered in arrival order once the receive
+ * buffer has been drained. Nothing here waits on the network.
+ *
+ * Acks and rejects addressed to us are not answered, nor are messages from
+ * our own callsign, so two bots can never talk to each other forever.
+ *
+ * A retry of a message already answered is only re-acked; it does not cost
+ * another pickAphorism() file scan or reply.
+ */
+
+#include "aprsResponder.h"
+
+#include <Arduino.h>		   // Arduino functions
+#include "aphorismGenerator.h" // pickAphorism()
+#include "aprsMultipart.h"	   // sendAPRSText()
+#include "aprsService.h"	   // APRSsendACK(), APRSsendMessage()
+#include "credentials.h"	   // CALLSIGN, APHORISM_FILE
+#include "wug_debug.h"		   // debug print macro
+
+struct PendingReply
+{
+	char sender[APRS_ADDRESSEE_WIDTH + 1];
+	char msgID[APRS_MSG_ID_MAX + 1];
+	unsigned long rxMicros;
+	bool ackOnly; // retry of a message already answered
+	bool acked;	  // ack sent, the reply may still be waiting
+};
+
+APRSResponderStats responderStats;
+APRSDedupeTable aprsDedupe; // recently answered (source, msgID) pairs
+
+static PendingReply replyQueue[APRS_REPLY_QUEUE_SIZE];
+static int replyHead = 0;  // oldest pending reply
+static int replyCount = 0; // pending replies
+
+//! Copies a field view into a fixed buffer, truncating to fit.
+static void copyField(char *dest, size_t size, const APRSField &field)
+{
+	size_t len = field.length < size - 1 ? field.length : size - 1;
+	memcpy(dest, field.text, len);
+	dest[len] = '\0';
+}
+
+//! True for "ackNN" and "rejNN" messages, which are never answered.
+static bool isAckOrReject(const APRSPacket &packet)
+{
+	if (packet.msgID.length != 0 || packet.text.length < 3)
+	{
+		return false;
+	}
+	return memcmp(packet.text.text, "ack", 3) == 0 || memcmp(packet.text.text, "rej", 3) == 0;
+}
+
+/**
+ * @brief Queues a reply to a message addressed to CALLSIGN.
+ *
+ * A message whose source and ID are in the duplicate table is queued for an
+ * ack only.
+ *
+ * @param packet   Parsed message; its views are copied before returning.
+ * @param rxMicros micros() when the packet was received, for the latency figure.
+ * @return true if a reply was queued.
+ */
+bool queueAPRSReply(const APRSPacket &packet, unsigned long rxMicros)
+{
+	if (packet.type != APRS_TYPE_MESSAGE || isAckOrReject(packet) ||
+		packet.source.equals(CALLSIGN.c_str()))
+	{
+		return false;
+	}
+	if (replyCount == APRS_REPLY_QUEUE_SIZE)
+	{
+		responderStats.dropped++;
+		DEBUG_PRINTLN(F("APRS reply queue full"));
+		return false;
+	}
+
+	bool retry = packet.msgID.length > 0 && aprsDedupe.seen(packet.source, packet.msgID, millis());
+
+	PendingReply &reply = replyQueue[(replyHead + replyCount) % APRS_REPLY_QUEUE_SIZE];
+	copyField(reply.sender, sizeof(reply.sender), packet.source);
+	copyField(reply.msgID, sizeof(reply.msgID), packet.msgID);
+	reply.rxMicros = rxMicros;
+	reply.ackOnly = retry;
+	reply.acked = false;
+	replyCount++;
+	if (retry)
+	{
+		responderStats.retries++;
+	}
+	else
+	{
+		responderStats.queries++;
+	}
+	return true;
+}
+
+/**
+ * @brief Acks and answers all queued queries.
+ *
+ * Called from pollAPRS() after the receive buffer has been drained, so a query
+ * is answered in the same loop() pass that read it. Every pending query is
+ * acked at once; the replies go out in arrival order. A long aphorism picked
+ * while every multi-part slot is busy is passed over for the next one that
+ * fits a single message; if none turns up in APRS_REPLY_PICKS_MAX picks the
+ * reply, and those behind it, wait for a later pass.
+ */
+void serviceAPRSResponder()
+{
+	for (int i = 0; i < replyCount; i++)
+	{
+		PendingReply &reply = replyQueue[(replyHead + i) % APRS_REPLY_QUEUE_SIZE];
+		if (!reply.acked && reply.msgID[0] != '\0')
+		{
+			APRSsendACK(reply.sender, reply.msgID);
+			responderStats.acks++;
+		}
+		reply.acked = true;
+	}
+
+	while (replyCount > 0)
+	{
+		PendingReply &reply = replyQueue[replyHead];
+
+		if (reply.ackOnly)
+		{
+			replyHead = (replyHead + 1) % APRS_REPLY_QUEUE_SIZE;
+			replyCount--;
+			continue;
+		}
+		String aphorism = pickAphorism(APHORISM_FILE);
+		aphorism.trim();
+		if (aphorism.length() > (unsigned)APRS_MESSAGE_MAX && !aprsMultipartSlotFree())
+		{
+			// every multi-part slot is busy: the next aphorism that fits one message
+			for (int tries = 1; tries < APRS_REPLY_PICKS_MAX && aphorism.length() > (unsigned)APRS_MESSAGE_MAX; tries++)
+			{
+				aphorism = pickAphorism(APHORISM_FILE);
+				aphorism.trim();
+			}
+			if (aphorism.length() > (unsigned)APRS_MESSAGE_MAX)
+			{
+				responderStats.deferred++; // try again on a later pass
+				return;
+			}
+		}
+		if (aphorism.length() > 0 &&
+			sendAPRSText(MULTIPART_MESSAGE, reply.sender, aphorism.c_str(), aphorism.length()))
+		{
+			responderStats.replies++; // long ones follow in parts
+		}
+
+		unsigned long latency = micros() - reply.rxMicros;
+		responderStats.lastLatencyUs = latency;
+		responderStats.totalLatencyUs += latency;
+		if (latency > responderStats.maxLatencyUs)
+		{
+			responderStats.maxLatencyUs = latency;
+		}
+		DEBUG_PRINT(F("APRS reply latency us: "));
+		DEBUG_PRINTLN(latency);
+
+		replyHead = (replyHead + 1) % APRS_REPLY_QUEUE_SIZE;
+		replyCount--;
+	}
+}
+
+// End of file
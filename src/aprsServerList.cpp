@@ -0,0 +1,175 @@
+/**
+ * @file aprsServerList.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the APRS-IS server failover list.
+ *
+ * Backoff after n consecutive failures is APRS_BACKOFF_BASE_MS * 2^(n-1),
+ * capped at APRS_BACKOFF_MAX_MS. Half of it is fixed and half is random so a
+ * group of units restarted together do not reconnect in step.
+ */
+
+#include "aprsServerList.h"
+
+static const unsigned long UNMEASURED = 0xFFFFFFFFUL; // rank of an endpoint with no samples
+
+//! Records a sample in a rolling window.
+static void addSample(uint16_t *window, uint8_t &samples, uint8_t &next, unsigned long value)
+{
+	window[next] = (value > 0xFFFF) ? 0xFFFF : (uint16_t)value;
+	next = (next + 1) % APRS_LATENCY_SAMPLES;
+	if (samples < APRS_LATENCY_SAMPLES)
+	{
+		samples++;
+	}
+}
+
+//! Average of a rolling window, UNMEASURED if empty.
+static unsigned long average(const uint16_t *window, uint8_t samples)
+{
+	if (samples == 0)
+	{
+		return UNMEASURED;
+	}
+	unsigned long sum = 0;
+	for (uint8_t i = 0; i < samples; i++)
+	{
+		sum += window[i];
+	}
+	return sum / samples;
+}
+
+APRSServerList::APRSServerList()
+	: _list(nullptr), _count(0)
+{
+}
+
+/**
+ * @brief Sets the endpoints in order of preference and clears their history.
+ *
+ * @param list  Endpoints; the array must outlive the server list.
+ * @param count Entries in list, at most APRS_MAX_SERVERS are used.
+ */
+void APRSServerList::begin(const APRSEndpoint *list, int count)
+{
+	_list = list;
+	_count = (count < APRS_MAX_SERVERS) ? count : APRS_MAX_SERVERS;
+	for (int i = 0; i < APRS_MAX_SERVERS; i++)
+	{
+		_health[i] = APRSEndpointHealth();
+	}
+}
+
+/**
+ * @brief Picks the endpoint to try next.
+ *
+ * @param now Current millis().
+ * @return Index of the endpoint, or -1 if every endpoint is backing off.
+ */
+int APRSServerList::select(unsigned long now) const
+{
+	int best = -1;
+	unsigned long bestScore = 0;
+	for (int i = 0; i < _count; i++)
+	{
+		const APRSEndpointHealth &h = _health[i];
+		if (h.consecutive > 0 && (long)(now - h.retryAt) < 0)
+		{
+			continue; // backing off
+		}
+		unsigned long connect = avgConnectMs(i);
+		unsigned long logresp = avgLogrespMs(i);
+		unsigned long score = (connect == UNMEASURED || logresp == UNMEASURED) ? UNMEASURED : connect + logresp;
+		if (best < 0 || h.consecutive < _health[best].consecutive ||
+			(h.consecutive == _health[best].consecutive && score < bestScore))
+		{
+			best = i;
+			bestScore = score;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Time until some endpoint comes out of backoff.
+ *
+ * @param now Current millis().
+ * @return Milliseconds to wait, 0 if an endpoint can be tried now.
+ */
+unsigned long APRSServerList::nextRetry(unsigned long now) const
+{
+	unsigned long wait = APRS_BACKOFF_MAX_MS;
+	for (int i = 0; i < _count; i++)
+	{
+		const APRSEndpointHealth &h = _health[i];
+		long left = (long)(h.retryAt - now);
+		if (h.consecutive == 0 || left <= 0)
+		{
+			return 0;
+		}
+		if ((unsigned long)left < wait)
+		{
+			wait = left;
+		}
+	}
+	return wait;
+}
+
+//! Counts a connection attempt.
+void APRSServerList::recordAttempt(int index)
+{
+	_health[index].attempts++;
+}
+
+//! Records a successful TCP connect and how long it took.
+void APRSServerList::recordConnect(int index, unsigned long connectMs)
+{
+	APRSEndpointHealth &h = _health[index];
+	addSample(h.connectMs, h.connectSamples, h.connectNext, connectMs);
+}
+
+//! Records a verified logon and the logon-to-logresp time; ends any backoff.
+void APRSServerList::recordLogon(int index, unsigned long logrespMs)
+{
+	APRSEndpointHealth &h = _health[index];
+	h.logons++;
+	h.consecutive = 0;
+	addSample(h.logrespMs, h.logrespSamples, h.logrespNext, logrespMs);
+}
+
+/**
+ * @brief Records a failed attempt or a dropped session and starts a backoff.
+ *
+ * @param index  Endpoint that failed.
+ * @param now    Current millis().
+ * @param random Any random number, for the jitter.
+ */
+void APRSServerList::recordFailure(int index, unsigned long now, uint32_t random)
+{
+	APRSEndpointHealth &h = _health[index];
+	h.failures++;
+	if (h.consecutive < 31)
+	{
+		h.consecutive++;
+	}
+
+	unsigned long delay = APRS_BACKOFF_MAX_MS;
+	if (h.consecutive <= 20 && (APRS_BACKOFF_BASE_MS << (h.consecutive - 1)) < APRS_BACKOFF_MAX_MS)
+	{
+		delay = APRS_BACKOFF_BASE_MS << (h.consecutive - 1);
+	}
+	delay = delay / 2 + random % (delay / 2 + 1);
+	h.retryAt = now + delay;
+}
+
+unsigned long APRSServerList::avgConnectMs(int index) const
+{
+	return average(_health[index].connectMs, _health[index].connectSamples);
+}
+
+unsigned long APRSServerList::avgLogrespMs(int index) const
+{
+	return average(_health[index].logrespMs, _health[index].logrespSamples);
+}
+
+// End of file
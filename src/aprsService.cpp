@@ -9,12 +9,26 @@
 
 #include <Arduino.h>		   // Arduino functions
 #include "aphorismGenerator.h" // aphorism generator for bulletins
+#include "aprsCapture.h"	   // stream capture and replay
+#include "aprsLineReader.h"	   // fixed-buffer line reader
+#include "aprsMetrics.h"	   // counters and timings
+#include "aprsMultipart.h"	   // long texts in parts
+#include "aprsPacketBuilder.h" // outbound packets without String
+#include "aprsParser.h"		   // TNC2 packet parser
+#include "aprsResponder.h"	   // answers queries with aphorisms
+#include "aprsServerList.h"	   // server failover list
+#include "aprsTxQueue.h"	   // non-blocking transmit queue
 #include "credentials.h"	   // APRS, Wi-Fi and weather station credentials
 #include "timeFunctions.h"	   // time functions
+#include <ESP8266WiFi.h>		   // WiFi.hostByName()
 #include <WiFiClient.h>		   // APRS connection
 #include "wug_debug.h"		   // debug print macro
 
-WiFiClient client; // APRS-IS client connection
+WiFiClient client;			// APRS-IS client connection
+APRSLineReader aprsReader; // APRS-IS receive buffer
+APRSTxQueue aprsTx;		   // APRS-IS transmit queue
+APRSServerList aprsServers; // APRS-IS endpoints and their health
+int aprsServerIndex = -1;	// endpoint of the current connection
 
 //! ***************** APRS *******************
 //            !!! DO NOT CHANGE !!!
@@ -25,27 +39,35 @@ WiFiClient client; // APRS-IS client connection
 // Asia: asia.aprs2.net
 // Africa: africa.aprs2.net
 // Oceania: apan.aprs2.net
-const char *APRS_SERVER = "noam.aprs2.net";					  // recommended for North America
 const char *APRS_DEVICE_NAME = "https://w4krl.com/iot-kits/"; // link to my website
 // #define APRS_SOFTWARE_NAME "D1S-VEVOR"						  // unit ID
 #define APRS_SOFTWARE_VERS FW_VERSION // FW version
 #define APRS_PORT 14580				  // do not change port
-#define APRS_TIMEOUT 2000L			  // milliseconds
-const int APRS_BUFFER_SIZE = 513;	  // APRS buffer size, must be at least 512 bytes + 1 for null terminator
+#define APRS_TIMEOUT 2000L			  // milliseconds, per logon step
+#define APRS_CONNECT_TIMEOUT 1000L	  // milliseconds, TCP connect to a server not yet reached
+#define APRS_CONNECT_MIN 20L		  // milliseconds, shortest TCP connect allowed
+#define APRS_CONNECT_MARGIN 3		  // TCP connect allowed, in multiples of the server's usual time
+#define APRS_DNS_SLICE 5L			  // milliseconds a name lookup may block in one pass
+#define APRS_RETRY_INTERVAL 5000L	  // milliseconds between connection attempts
+#define APRS_KEEPALIVE_INTERVAL 20000L // milliseconds, servers send "#" lines this often
+#ifndef APRS_FILTER_BASELINE
+#define APRS_FILTER_BASELINE 300000L // milliseconds on a filter before it is measured or replaced
+#endif
+#ifndef APRS_IDLE_GRACE
+#define APRS_IDLE_GRACE 10000L // milliseconds of silence past a missed keepalive before reconnecting
+#endif
+
+// servers in order of preference, the fastest healthy one is used
+const APRSEndpoint APRS_SERVERS[] = {
+	{"noam.aprs2.net", APRS_PORT},	 // recommended for North America
+	{"rotate.aprs2.net", APRS_PORT}, // any tier 2 server
+	{"rotate.aprs.net", APRS_PORT},	 // core servers
+};
 
 // *******************************************************
 // ******************* GLOBALS ***************************
 // *******************************************************
-// APRS Data Type Identifiers
-// page 17 http://www.aprs.org/doc/APRS101.PDF
-const char APRS_ID_POSITION_NO_TIMESTAMP = '!';
-const char APRS_ID_TELEMETRY = 'T';
-const char APRS_ID_WEATHER = '_';
-const char APRS_ID_MESSAGE = ':';
-const char APRS_ID_QUERY = '?';
-const char APRS_ID_STATUS = '>';
-const char APRS_ID_USER_DEF = '{';
-const char APRS_ID_COMMENT = '#';
+// APRS Data Type Identifiers are declared in aprsParser.h
 String APRSdataMessage = "";   // message text
 String APRSdataWeather = "";   // weather data
 String APRSdataTelemetry = ""; // telemetry data
@@ -54,59 +76,333 @@ char APRSage[9] = "";		   // time stamp for received data
 
 // Global state tracker
 enum APRS_State {
-  APRS_DISCONNECTED,
-  APRS_CONNECTED,
-  APRS_LOGGED_IN,
-  APRS_VERIFIED
+  APRS_DISCONNECTED,     // waiting for the next connection attempt
+  APRS_RESOLVING,        // looking up the server's address
+  APRS_CONNECTING,       // TCP connected, waiting for the server banner
+  APRS_LOGON_SENT,       // logon line queued, waiting for it to be written
+  APRS_AWAITING_LOGRESP, // logon written, waiting for "# logresp"
+  APRS_VERIFIED          // logged on, packets flowing
 };
 APRS_State aprsState = APRS_DISCONNECTED;
+unsigned long aprsStateStamp = 0; // millis() when aprsState last changed
+unsigned long aprsLastByteStamp = 0; // millis() when the server last sent anything
+APRSSessionStats aprsSessions;	  // verified session history
+
+//! ************ APRS packet prefixes ***************
+// composed once from credentials.cpp by buildAPRSHeaders()
+const int APRS_LOGON_HEADER_SIZE = 80;								// logon line up to the filter + 1
+static char aprsSourceHeader[APRS_CALLSIGN_MAX + 14] = "";			// "W4KRL-2>APRS,TCPIP*:"
+static size_t aprsSourceHeaderLength = 0;							// 0 until built
+static char aprsOwnAddressee[APRS_ADDRESSEE_WIDTH + 1] = "";		// "W4KRL-2  "
+static char aprsLogonHeader[APRS_LOGON_HEADER_SIZE] = "";			// "user ... filter "
+static size_t aprsLogonHeaderLength = 0;							// 0 until built
+
+//! ************ APRS server-side filter ***************
+char aprsFilter[APRS_FILTER_SIZE] = "";	// filter in effect, sent at logon and by #filter
+unsigned long aprsFilterSinceMs = 0;	// millis() when aprsFilter took effect
+unsigned long aprsFilterSinceBytes = 0; // bytes received before that
+APRSFilterStats aprsFilterStats;		// inbound volume around filter changes
+
+//! ************ APRS receive counters ***************
+unsigned long aprsFastRejected = 0;	 // packets not addressed to CALLSIGN
+unsigned long aprsPacketsParsed = 0; // packets parsed successfully
+unsigned long aprsParseErrors = 0;	 // malformed packets
+
+/**
+ * @brief Composes the packet prefixes that depend only on the credentials.
+ *
+ * The source header, CALLSIGN padded as an addressee and the logon line up to
+ * its filter are built once, so each packet starts with a single copy of its
+ * prefix. Called from setup(); the packet formatters call it themselves if
+ * it has not run.
+ *
+ * @return false if CALLSIGN is not a valid source or the logon is too long.
+ */
+bool buildAPRSHeaders() {
+    APRSPacketBuilder packet;
+    packet.header(CALLSIGN.c_str());
+    if (!packet.ok() || packet.length() >= sizeof(aprsSourceHeader)) {
+        DEBUG_PRINTLN(F("APRS callsign not usable as a source"));
+        return false;
+    }
+    memcpy(aprsSourceHeader, packet.c_str(), packet.length() + 1);
+
+    packet.reset();
+    packet.appendPadded(CALLSIGN.c_str(), APRS_ADDRESSEE_WIDTH);
+    memcpy(aprsOwnAddressee, packet.c_str(), packet.length() + 1);
+
+    packet.reset();
+    packet.append("user ");
+    packet.append(CALLSIGN.c_str());
+    packet.append(" pass ");
+    packet.append(APRS_PASSCODE.c_str());
+    packet.append(" ver ");
+    packet.append(APRS_SOFTWARE_NAME.c_str());
+    packet.append(' ');
+    packet.append(APRS_SOFTWARE_VERS.c_str());
+    packet.append(" filter ");
+    if (!packet.ok() || packet.length() >= sizeof(aprsLogonHeader)) {
+        DEBUG_PRINTLN(F("APRS logon line too long"));
+        return false;
+    }
+    memcpy(aprsLogonHeader, packet.c_str(), packet.length() + 1);
+
+    aprsLogonHeaderLength = packet.length();
+    aprsSourceHeaderLength = strlen(aprsSourceHeader);
+    return true;
+}
+
+/**
+ * @brief Starts a packet from CALLSIGN with the prebuilt source header.
+ *
+ * @return false if the header cannot be built.
+ */
+static bool startAPRSPacket(APRSPacketBuilder &packet) {
+    packet.reset();
+    if (aprsSourceHeaderLength == 0 && !buildAPRSHeaders()) {
+        return false;
+    }
+    return packet.append(aprsSourceHeader, aprsSourceHeaderLength);
+}
+
+/**
+ * @brief Builds the APRS-IS logon line.
+ *
+ * The prebuilt logon header, with the configured callsign, passcode, software
+ * name and version, followed by the filter in effect.
+ *
+ * @param packet Receives the logon line without its terminator.
+ * @return false if it does not fit.
+ */
+bool APRSbuildLogon(APRSPacketBuilder &packet) {
+    packet.reset();
+    if (aprsLogonHeaderLength == 0 && !buildAPRSHeaders()) {
+        return false;
+    }
+    packet.append(aprsLogonHeader, aprsLogonHeaderLength);
+    packet.append(aprsFilter);
+    return packet.ok();
+}
 
-//! ************ APRS Bulletin globals ***************
-// int *lineArray;				 // holds shuffled index to aphorisms
-int lineCount;				 // number of aphorisms in file
-bool amBulletinSent = false; // APRS morning bulletin
-bool pmBulletinSent = false; // APRS evening bulletin
-int lineIndex = 1;			 // APRS bulletin index
+/**
+ * @brief Returns the APRS-IS logon line, see APRSbuildLogon().
+ */
+String APRSlogonString() {
+    APRSPacketBuilder packet;
+    APRSbuildLogon(packet);
+    return String(packet.c_str());
+}
 
 /**
  * @brief Performs the APRS-IS logon procedure.
  *
- * Constructs the APRS-IS logon string using the configured callsign, passcode,
- * software name, version, and filter, then sends it to the APRS-IS server.
+ * Constructs the APRS-IS logon string with APRSbuildLogon(), then sends it to the APRS-IS server.
  * Also outputs the logon string to the debug interface for logging purposes.
  *
  * Dependencies:
  * - Assumes global variables/constants: CALLSIGN, APRS_PASSCODE, APRS_SOFTWARE_NAME,
- *   APRS_SOFTWARE_VERS, APRS_FILTER, and client are defined and accessible.
+ *   APRS_SOFTWARE_VERS, and client are defined and accessible.
+ * - The filter is the one in effect, APRS_FILTER until setAPRSFilter() changes it.
  * - Uses DEBUG_PRINTLN for debug output.
+ * - The logon line goes through the transmit queue, which is serviced at once.
  */
 void performAPRSLogon() {
-    // Construct the APRS-IS logon string
-    String dataString = "user " + CALLSIGN;
-    dataString += " pass " + APRS_PASSCODE;
-    dataString += " ver " + APRS_SOFTWARE_NAME + " " + APRS_SOFTWARE_VERS;
-    dataString += " filter " + APRS_FILTER;
+    if (aprsFilter[0] == '\0') {
+        setAPRSFilter(APRS_FILTER.c_str());
+    }
+    APRSPacketBuilder packet;
+    APRSbuildLogon(packet);
 
     // Send the logon string to the server
-    client.println(dataString);
-    DEBUG_PRINTLN("APRS logon: " + dataString);
+    aprsTx.enqueue(packet.c_str(), packet.length(), millis());
+    serviceAPRSTx();
+    DEBUG_PRINT(F("APRS logon: "));
+    DEBUG_PRINTLN(packet.c_str());
+}
+
+/**
+ * @brief Inbound byte rate since the current filter took effect.
+ *
+ * @return Bytes per hour received under the current filter.
+ */
+unsigned long aprsFilterBytesPerHour() {
+    unsigned long elapsed = millis() - aprsFilterSinceMs;
+    if (elapsed == 0) {
+        return 0;
+    }
+    uint64_t bytes = aprsReader.bytesRead() - aprsFilterSinceBytes;
+    return (unsigned long)(bytes * 3600000ULL / elapsed);
 }
 
 /**
- * @brief Establishes a connection to the APRS network and verifies logon status.
+ * @brief Changes the APRS-IS server-side filter without reconnecting.
+ *
+ * The filter is sent in-band as a "#filter" command when logged on and is used
+ * for every later logon. The inbound byte rate under the old filter is kept in
+ * aprsFilterStats and printed; the rate under the new one is sampled and
+ * printed by updateAPRS() once it has run for APRS_FILTER_BASELINE.
  *
- * This function attempts to connect to the APRS network. If the connection is successful,
- * it updates the APRS state to APRS_CONNECTED and performs the APRS logon procedure.
- * After logging on, it verifies the logon status, and if successful, updates the APRS state
- * to APRS_VERIFIED.
+ * @param filter APRS-IS filter, e.g. "g/W4KRL-2 b/W4KRL-2".
+ * @return false if the filter is too long.
+ */
+bool setAPRSFilter(const char *filter) {
+    if (strlen(filter) >= APRS_FILTER_SIZE) {
+        DEBUG_PRINTLN(F("APRS filter too long"));
+        return false;
+    }
+
+    if (aprsFilter[0] != '\0') {
+        aprsFilterStats.changes++;
+        aprsFilterStats.beforeBytesPerHour = aprsFilterBytesPerHour();
+        DEBUG_PRINT(F("APRS filter "));
+        DEBUG_PRINT(aprsFilter);
+        DEBUG_PRINT(F(" received bytes/hour: "));
+        DEBUG_PRINTLN(aprsFilterStats.beforeBytesPerHour);
+        aprsFilterStats.afterPending = true;
+    }
+    strcpy(aprsFilter, filter);
+    aprsFilterSinceMs = millis();
+    aprsFilterSinceBytes = aprsReader.bytesRead();
+
+    if (aprsState == APRS_VERIFIED) {
+        APRSPacketBuilder packet;
+        packet.append("#filter ");
+        packet.append(aprsFilter);
+        if (packet.ok()) {
+            postToAPRS(packet.c_str(), packet.length());
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Applies APRS_RUNTIME_FILTER and measures the filter it replaced.
+ *
+ * Called while logged on. After APRS_FILTER_BASELINE on the logon filter the
+ * runtime filter is sent once; after another APRS_FILTER_BASELINE the byte
+ * rate under the new filter is kept in aprsFilterStats and printed next to
+ * the rate before the change.
+ */
+static void updateAPRSFilter() {
+    if (millis() - aprsFilterSinceMs < APRS_FILTER_BASELINE) {
+        return;
+    }
+    if (aprsFilterStats.afterPending) {
+        aprsFilterStats.afterPending = false;
+        aprsFilterStats.afterBytesPerHour = aprsFilterBytesPerHour();
+        DEBUG_PRINT(F("APRS filter "));
+        DEBUG_PRINT(aprsFilter);
+        DEBUG_PRINT(F(" received bytes/hour: "));
+        DEBUG_PRINT(aprsFilterStats.afterBytesPerHour);
+        DEBUG_PRINT(F(", before: "));
+        DEBUG_PRINTLN(aprsFilterStats.beforeBytesPerHour);
+    }
+    if (!aprsFilterStats.runtimeApplied && APRS_RUNTIME_FILTER.length() > 0) {
+        aprsFilterStats.runtimeApplied = true;
+        setAPRSFilter(APRS_RUNTIME_FILTER.c_str());
+    }
+}
+
+/**
+ * @brief Moves the APRS state machine to a new state and starts its deadline.
+ *
+ * @param state The new state.
+ */
+void setAPRSState(APRS_State state) {
+  unsigned long now = millis();
+
+  // session bookkeeping, a session runs from logon verified to disconnect
+  if (state == APRS_VERIFIED && aprsState != APRS_VERIFIED) {
+    if (aprsSessions.sessions > 0) {
+      aprsSessions.reconnects++;
+    }
+    aprsSessions.sessions++;
+    aprsSessions.sessionStart = now;
+  } else if (state != APRS_VERIFIED && aprsState == APRS_VERIFIED) {
+    unsigned long length = now - aprsSessions.sessionStart;
+    aprsSessions.lastSessionMs = length;
+    aprsSessions.totalSessionMs += length;
+    if (length > aprsSessions.longestSessionMs) {
+      aprsSessions.longestSessionMs = length;
+    }
+  }
+
+  aprsState = state;
+  aprsStateStamp = now;
+}
+
+/**
+ * @brief Returns how long the current APRS-IS session has been verified.
+ *
+ * @return Milliseconds since logon was verified, 0 if not logged on.
+ */
+unsigned long aprsSessionMillis() {
+  return (aprsState == APRS_VERIFIED) ? millis() - aprsSessions.sessionStart : 0;
+}
+
+/**
+ * @brief Closes the APRS-IS connection and waits for the next attempt.
+ *
+ * @param reason Debug text saying why.
+ * @param serverFault true if the server misbehaved (logon failed, went silent),
+ *                    which backs that server off in favour of the others.
+ */
+void dropAPRSConnection(const __FlashStringHelper *reason, bool serverFault) {
+  (void)reason; // only printed with WUG_DEBUG
+  DEBUG_PRINTLN(reason);
+  if (serverFault && aprsServerIndex >= 0) {
+    aprsServers.recordFailure(aprsServerIndex, millis(), random(0x7FFFFFFF));
+  }
+  client.stop();
+  aprsTx.clear();
+  clearAPRSMultipart();
+  setAPRSState(APRS_DISCONNECTED);
+}
+
+/**
+ * @brief Starts a connection to the APRS-IS server.
+ *
+ * Picks the fastest healthy server from the server list and moves the APRS state
+ * to APRS_RESOLVING; the name lookup, the TCP connect and the logon are then
+ * carried out step by step by updateAPRS(). A cached name is connected at once.
  */
 void connectToAPRSserver() {
-  if (connectToAPRS()) {
-    aprsState = APRS_CONNECTED;
-    performAPRSLogon();
-    if (verifyLogonStatus()) {
-      aprsState = APRS_VERIFIED;
+  if (client.connected()) {
+    setAPRSState(APRS_CONNECTING);
+    return;
+  }
+  aprsServerIndex = aprsServers.select(millis());
+  if (aprsServerIndex < 0) {
+    setAPRSState(APRS_DISCONNECTED); // every server is backing off
+    return;
+  }
+  aprsServers.recordAttempt(aprsServerIndex);
+  DEBUG_PRINT(F("APRS connecting to "));
+  DEBUG_PRINTLN(aprsServers.endpoint(aprsServerIndex).host);
+  setAPRSState(APRS_RESOLVING);
+  resolveAPRSserver();
+}
+
+/**
+ * @brief Looks up the selected server's address, then connects to it.
+ *
+ * Each call waits at most APRS_DNS_SLICE for the answer. The lookup goes on in
+ * the network stack meanwhile and its answer is cached, so a later call finds
+ * it at once. Gives up on the server after APRS_TIMEOUT.
+ */
+void resolveAPRSserver() {
+  IPAddress address;
+  if (WiFi.hostByName(aprsServers.endpoint(aprsServerIndex).host, address, APRS_DNS_SLICE)) {
+    if (connectToAPRS()) {
+      setAPRSState(APRS_CONNECTING);
+    } else {
+      setAPRSState(APRS_DISCONNECTED);
     }
+  } else if (millis() - aprsStateStamp > APRS_TIMEOUT) {
+    aprsServers.recordFailure(aprsServerIndex, millis(), random(0x7FFFFFFF));
+    metricsCount(METRIC_CONNECT_FAILED);
+    DEBUG_PRINTLN(F("APRS server name not found."));
+    setAPRSState(APRS_DISCONNECTED);
   }
 }
 
@@ -115,7 +411,7 @@ void connectToAPRSserver() {
 ************** Format Bulletin for APRS-IS ************
 *******************************************************
 */
-String APRSformatBulletin(String message, String ID)
+bool APRSbuildBulletin(APRSPacketBuilder &packet, const char *message, const char *ID)
 {
 	// format bulletin or announcement
 	/* APRS101.pdf pg 83
@@ -127,11 +423,63 @@ String APRSformatBulletin(String message, String ID)
 	 *  |1| 3 | 1|  5  |1| 0 to 67 |
 	 *  |_|___|__|_____|_|_________|
 	 */
-	String str = CALLSIGN + ">APRS,TCPIP*:" + ":BLN" + ID + "     :" + message;
-	DEBUG_PRINTLN("APRS Bulletin: " + str);
-	return str;
+	static const char BULLETIN_ADDRESSEE[] = ":BLN?     :"; // ? is the ID
+	const size_t ID_OFFSET = 4;
+
+	if (strlen(ID) != 1 || !startAPRSPacket(packet))
+	{
+		packet.reset();
+		return false;
+	}
+	char addressee[sizeof(BULLETIN_ADDRESSEE)];
+	memcpy(addressee, BULLETIN_ADDRESSEE, sizeof(addressee));
+	addressee[ID_OFFSET] = ID[0];
+	packet.append(addressee, sizeof(addressee) - 1);
+	packet.appendMessageText(message);
+	return packet.ok();
+} // APRSbuildBulletin()
+
+String APRSformatBulletin(const char *message, const char *ID)
+{
+	APRSPacketBuilder packet;
+	if (!APRSbuildBulletin(packet, message, ID))
+	{
+		return String();
+	}
+	DEBUG_PRINT(F("APRS Bulletin: "));
+	DEBUG_PRINTLN(packet.c_str());
+	return String(packet.c_str());
 } // APRSformatBulletin()
 
+// *******************************************************
+// ************ Format message and ack *******************
+// *******************************************************
+bool APRSbuildAck(APRSPacketBuilder &packet, const char *recipient, const char *msgID)
+{
+	// ack of a message with ID pg 72
+	if (strlen(msgID) > APRS_MSG_ID_MAX || !startAPRSPacket(packet))
+	{
+		packet.reset();
+		return false;
+	}
+	packet.appendAddressee(recipient); // pad to 9 characters
+	packet.append("ack", 3);
+	packet.append(msgID);
+	return packet.ok();
+} // APRSbuildAck()
+
+bool APRSbuildMessage(APRSPacketBuilder &packet, const char *recipient, const char *message)
+{
+	// message without ID, no ack expected pg 71
+	if (!startAPRSPacket(packet))
+	{
+		return false;
+	}
+	packet.appendAddressee(recipient); // pad to 9 characters
+	packet.appendMessageText(message);
+	return packet.ok();
+} // APRSbuildMessage()
+
 /*
 *******************************************************
 ****************** APRS padder ************************
@@ -140,12 +488,9 @@ String APRSformatBulletin(String message, String ID)
 String APRSpadder(float value, int width)
 {
 	// pads APRS rounded data element with leading 0s to the specified width
-	int val = round(value);
-	char format[6]; // Stores the string format specifier (e.g., "%04d")
-	snprintf(format, sizeof(format), "%%0%dd", width);
-	char paddedValue[width + 1]; // Buffer to store the formatted string
-	snprintf(paddedValue, sizeof(paddedValue), format, val);
-	return paddedValue;
+	APRSPacketBuilder field;
+	field.appendZeroPadded(lround(value), width);
+	return String(field.c_str());
 } // APRSpadder()
 
 /*
@@ -153,14 +498,13 @@ String APRSpadder(float value, int width)
 *********** Format callsign for APRS telemetry ********
 *******************************************************
 */
-String APRSpadCall(String callSign)
+String APRSpadCall(const char *callSign)
 {
 	// 12/20/2024
 	// pad to 9 characters including the SSID pg 12, 127
-	char paddedCall[10]; // 9 chars + null terminator
-	// print at most 9 characters
-	snprintf(paddedCall, sizeof(paddedCall), "%-9.9s", callSign.c_str());
-	return String(paddedCall);
+	APRSPacketBuilder field;
+	field.appendPadded(callSign, APRS_ADDRESSEE_WIDTH);
+	return String(field.c_str());
 } // APRSpadCall()
 
 /*
@@ -172,92 +516,58 @@ String APRSlocation(float lat, float lon)
 {
 	// 12/20/2024
 	// convert decimal latitude & longitude to DDmm.mmN/DDDmm.mmW
-	lat = constrain(lat, -90, 90);
-	lon = constrain(lon, -180, 180);
-
-	const char *latID = (lat < 0) ? "S" : "N";
-	const char *lonID = (lon < 0) ? "W" : "E";
-	lat = abs(lat);
-	lon = abs(lon);
-	uint8_t latDeg = (int)lat;			// the characteristic of lat (degrees)
-	float latMin = 60 * (lat - latDeg); // the mantissa of lat (minutes)
-	uint8_t lonDeg = (int)lon;
-	float lonMin = 60 * (lon - lonDeg);
-
-	char buf[20]; // Increased buffer size to safely accommodate the formatted string
-	snprintf(buf, sizeof(buf), "%02u%05.2f%.1s/%03u%05.2f%.1s",
-			 latDeg, latMin, latID, lonDeg, lonMin, lonID);
-	return String(buf);
+	APRSPacketBuilder field;
+	field.appendLocation(lat, lon);
+	return String(field.c_str());
 } // APRSlocation()
 
 
 /**
  * @brief Posts a message to the APRS-IS network.
  *
- * This function sends the specified message to the APRS-IS server if the client is connected.
- * If the connection is lost, it logs a debug message indicating the failure to post.
+ * This function queues the specified message for the APRS-IS server if the client is connected.
+ * The queue is drained by serviceAPRSTx() without blocking loop().
+ * If the connection is lost or the queue is full, it logs a debug message indicating the failure to post.
  *
  * @param message The APRS message to be posted as a String.
  */
 void postToAPRS(String message)
+{
+	postToAPRS(message.c_str(), message.length());
+}
+
+/**
+ * @brief Posts a line of length characters to the APRS-IS network, see postToAPRS(String).
+ */
+void postToAPRS(const char *line, size_t length)
 {
 	// post a message to APRS-IS
-	if (client.connected())
+	if (!client.connected())
+	{
+		DEBUG_PRINTLN(F("APRS connection lost. Cannot post message."));
+	}
+	else if (aprsTx.enqueue(line, length, millis()))
 	{
-		client.println(message);
-		DEBUG_PRINTLN("APRS posted: " + message);
+		DEBUG_PRINT(F("APRS posted: "));
+		DEBUG_PRINTLN(line);
 	}
 	else
 	{
-		DEBUG_PRINTLN(F("APRS connection lost. Cannot post message."));
+		DEBUG_PRINTLN(F("APRS transmit queue full. Message dropped."));
 	}
 }
 
 /**
- * @brief Processes and sends scheduled APRS bulletins.
- *
- * This function checks the current time and sends APRS bulletins at specific times of the day:
- * - At 08:00 EST, if the morning bulletin has not been sent, it selects an aphorism and sends it as a morning bulletin.
- * - At 20:00 EST, if the evening bulletin has not been sent, it selects an aphorism and sends it as an evening bulletin.
- * 
- * The function ensures that each bulletin is sent only once per day by using flags (`amBulletinSent` and `pmBulletinSent`).
- * These flags are reset at midnight to allow bulletins to be sent again the next day.
+ * @brief Writes queued lines to the APRS-IS server.
  *
- * Dependencies:
- * - `myTZ`: An object providing the current time (hour, minute, day).
- * - `pickAphorism()`: Function to select a bulletin message.
- * - `APRSsendBulletin()`: Function to send the bulletin.
- * - `APHORISM_FILE`, `lineArray`: Resources used for selecting aphorisms.
- * - `amBulletinSent`, `pmBulletinSent`: Flags indicating if bulletins have been sent.
+ * Writes only what the connection accepts without blocking; the rest is sent
+ * on a later call. Called every loop() pass from updateAPRS().
  */
-void processBulletins()
+void serviceAPRSTx()
 {
-	//! process APRS bulletins
-	//? Check if it is 0800 EST and the morning bulletin has not been sent
-	String bulletinText = "";
-	if (myTZ.hour() == 8 && myTZ.minute() == 0 && !amBulletinSent)
-	{
-		bulletinText = pickAphorism(APHORISM_FILE, lineArray);
-		APRSsendBulletin(bulletinText, "M"); // send morning bulletin
-		amBulletinSent = true;				 // mark it sent
-	}
-
-	//? Check if it is 2000 EST and the evening bulletin has not been sent
-	if (myTZ.hour() == 20 && myTZ.minute() == 0 && !pmBulletinSent)
-	{
-		bulletinText = pickAphorism(APHORISM_FILE, lineArray);
-		APRSsendBulletin(bulletinText, "E"); // send evening bulletin
-		pmBulletinSent = true;				 // mark it sent
-	}
-
-	//? Reset the bulletin flags at midnight if either is true
-	static int lastDay = -1;
-	int currentDay = myTZ.day();
-	if (currentDay != lastDay)
+	if (client.connected())
 	{
-		lastDay = currentDay;
-		amBulletinSent = false;
-		pmBulletinSent = false;
+		aprsTx.service(client, millis());
 	}
 }
 
@@ -269,73 +579,138 @@ void processBulletins()
  * the function will print a debug message and return without sending.
  *
  * @param message The bulletin message to send (maximum 67 characters).
- * @param ID The identifier for the bulletin.
+ * @param ID The identifier for the bulletin, one digit or upper-case letter.
  */
-void APRSsendBulletin(String message, String ID)
+void APRSsendBulletin(const char *message, const char *ID)
 {
 	// send a bulletin or announcement to APRS-IS
-	if (message.length() > 67)
+	APRSPacketBuilder packet;
+	if (!APRSbuildBulletin(packet, message, ID))
 	{
 		DEBUG_PRINTLN(F("APRS bulletin too long. Max 67 characters."));
 		return;
 	}
-
-	String bulletin = APRSformatBulletin(message, ID);
-	postToAPRS(bulletin);
+	postToAPRS(packet.c_str(), packet.length());
 } // APRSsendBulletin()
 
 // *******************************************************
 // **************** SEND APRS ACK ************************
 // *******************************************************
-void APRSsendACK(String recipient, String msgID)
+void APRSsendACK(const char *recipient, const char *msgID)
 {
-	String dataString = CALLSIGN;
-	dataString += ">APRS,TCPIP*:";
-	dataString += APRS_ID_MESSAGE;
-	dataString += APRSpadCall(recipient); // pad to 9 characters
-	dataString += APRS_ID_MESSAGE;
-	dataString += "ack";
-	dataString += msgID;
-	client.println(dataString); // send to APRS-IS
-	Serial.println(dataString); // print to serial port
+	APRSPacketBuilder packet;
+	if (!APRSbuildAck(packet, recipient, msgID))
+	{
+		DEBUG_PRINTLN(F("APRS ack not sent, bad addressee or message ID."));
+		return;
+	}
+	postToAPRS(packet.c_str(), packet.length()); // send to APRS-IS
 } // APRsendACK()
 
+// *******************************************************
+// **************** SEND APRS MESSAGE ********************
+// *******************************************************
+void APRSsendMessage(const char *recipient, const char *message)
+{
+	APRSPacketBuilder packet;
+	if (!APRSbuildMessage(packet, recipient, message))
+	{
+		DEBUG_PRINTLN(F("APRS message not sent, bad addressee or too long."));
+		return;
+	}
+	postToAPRS(packet.c_str(), packet.length()); // send to APRS-IS
+} // APRSsendMessage()
+
 /**
  * @brief Reads an APRS packet from the client connection.
  *
- * This function attempts to read a complete APRS packet from the client connection.
- * It waits for data to become available and reads it until a newline character is encountered.
- * If no data is available within a specified timeout, it closes the connection.
+ * This function frames the next complete line received from the client connection
+ * in the fixed APRS receive buffer. Only bytes already received are used, so it never waits.
+ * The time of the last received byte is kept for the idle watchdog in pollAPRS().
+ * While a replay is running the lines come from the capture file instead, and
+ * while a capture is running each live line is recorded.
  *
- * @param packet A reference to a String where the read packet will be stored.
+ * @param packet A reference to an APRSLine that receives a view of the packet.
+ *               The view is valid until the next call.
  * @return true if a packet was successfully read, false otherwise.
  */
-bool readAPRSPacket(String &packet) {
-    static unsigned long timeoutStamp = 0;
-    const unsigned long TIMEOUT_MS = 1500;
+bool readAPRSPacket(APRSLine &packet) {
+    static unsigned long lastBytesRead = 0;
+
+    if (aprsReplayActive()) {
+        return readAPRSReplay(aprsReader, packet);
+    }
 
     // If not connected, do not attempt to read
     if (!client.connected()) {
-        packet = "";
         return false;
     }
 
-    // If there is data available, read a line
-    if (client.available()) {
-        packet = client.readStringUntil('\n');
-        timeoutStamp = 0; // Reset timer on successful read
-        return (packet.length() > 0);
-    } else {
-        // Start or continue timeout timer
-        if (timeoutStamp == 0) {
-            timeoutStamp = millis();
-        } else if (millis() - timeoutStamp > TIMEOUT_MS) {
-            timeoutStamp = 0;
-            client.stop(); // Close connection on timeout
-        }
-        packet = "";
-        return false;
+    bool gotLine = aprsReader.readLine(client, packet);
+    if (aprsReader.bytesRead() != lastBytesRead) {
+        lastBytesRead = aprsReader.bytesRead();
+        aprsLastByteStamp = millis();
+    }
+    if (gotLine) {
+        captureAPRSLine(packet); // no-op unless capturing
     }
+    return gotLine;
+}
+
+/**
+ * @brief Handles a comment line sent by the APRS-IS server.
+ *
+ * Server lines start with '#': the software banner, logon response and the
+ * keepalives sent about every 20 seconds.
+ *
+ * @param line The server line.
+ */
+void processServerMessage(const APRSLine &line)
+{
+	(void)line; // only printed with WUG_DEBUG
+	DEBUG_PRINTLN(line.text);
+}
+
+/**
+ * @brief Parses and dispatches an APRS data packet.
+ *
+ * The packet is parsed in place into views of the receive buffer. Malformed
+ * packets are counted and dropped. Only lines that passed the addressee
+ * check in pollAPRS() get here.
+ *
+ * @param line The packet line.
+ */
+void processAPRSPacket(const APRSLine &line)
+{
+	unsigned long rxMicros = micros();
+	APRSPacket packet;
+	if (line.truncated || !parseAPRSPacket(line.text, line.length, packet))
+	{
+		aprsParseErrors++;
+		return;
+	}
+	aprsPacketsParsed++;
+
+	if (packet.type == APRS_TYPE_MESSAGE)
+	{
+		DEBUG_PRINT(F("APRS message: "));
+		DEBUG_PRINTLN(line.text);
+		queueAPRSReply(packet, rxMicros); // answered at the end of pollAPRS()
+	}
+}
+
+/**
+ * @brief Returns CALLSIGN padded to the 9-character addressee width.
+ *
+ * Prebuilt by buildAPRSHeaders(); the same form APRSpadCall() produces.
+ */
+static const char *ownPaddedCall()
+{
+	if (aprsOwnAddressee[0] == '\0')
+	{
+		buildAPRSHeaders();
+	}
+	return aprsOwnAddressee;
 }
 
 /**
@@ -343,58 +718,113 @@ bool readAPRSPacket(String &packet) {
  *
  * This function attempts to read an APRS packet into a buffer. If a packet is successfully read,
  * it processes the packet data and outputs the received packet to the serial console.
+ * Packets that are not messages to CALLSIGN are counted and dropped before the full parse.
+ * Queries read in this pass are answered before it returns.
+ * The server sends a "#" keepalive about every APRS_KEEPALIVE_INTERVAL, so the connection
+ * is only dropped after that plus APRS_IDLE_GRACE without a single byte.
  *
- * @note Relies on the functions readAPRSPacket(String&) and handleAPRSData(const String&).
+ * @note Relies on the functions readAPRSPacket(APRSLine&), processServerMessage() and processAPRSPacket().
  */
 void pollAPRS()
 {
-  if (aprsState != APRS_VERIFIED) return;
+  if (aprsState != APRS_VERIFIED && !aprsReplayActive()) return;
+  MetricScope timing(METRIC_POLL_APRS);
 
-  String packet;
+  APRSLine packet;
   while (readAPRSPacket(packet)) {
-    if (packet.startsWith("#")) {  // Handle server messages
-    //   processServerMessage(packet);
+    if (packet.text[0] == '#') {  // Handle server messages
+      processServerMessage(packet);
+    } else if (!aprsIsAddressedTo(packet.text, packet.length, ownPaddedCall())) {
+      aprsFastRejected++;           // not for us, drop before parsing
     } else {                        // Handle APRS data
-    //   processAPRSPacket(packet);
+      processAPRSPacket(packet);
     }
   }
+  serviceAPRSResponder(); // answer queries read above
+  serviceAPRSMultipart(); // later parts of long answers and bulletins
+  serviceAPRSTx();        // and start sending the answers
   
-  // Connection watchdog
-  if (!client.connected()) {
-    aprsState = APRS_DISCONNECTED;
-    DEBUG_PRINTLN(F("Connection lost"));
+  // Connection watchdog, idle while a replay stands in for the server
+  if (aprsReplayActive()) {
+    return;
+  } else if (!client.connected()) {
+    dropAPRSConnection(F("Connection lost"), false);
+  } else if (millis() - aprsLastByteStamp > APRS_KEEPALIVE_INTERVAL + APRS_IDLE_GRACE) {
+    dropAPRSConnection(F("APRS idle: no keepalive from server"), true);
   }
 }
 
 /**
- * @brief Verifies the logon status by reading APRS packets within a timeout period.
+ * @brief Classifies a logon response line.
+ *
+ * @param response A line received from the server.
+ * @return 1 if it reports a verified logon, -1 if unverified, 0 if it is not a logon response.
+ */
+int checkLogonResponse(const APRSLine &response) {
+    // Look for the logon response line
+    if (strncmp(response.text, "# logresp", 9) != 0) {
+        return 0;
+    }
+    if (strstr(response.text, "unverified") != nullptr) {
+        return -1;
+    }
+    return (strstr(response.text, "verified") != nullptr) ? 1 : 0;
+}
+
+/**
+ * @brief Advances the logon handshake by whatever has arrived since the last call.
  *
- * This function waits for a response from the APRS server indicating the logon status.
- * It reads incoming APRS packets until either a verified or unverified logon response is received,
- * or until the timeout period (APRS_TIMEOUT) elapses.
+ * Each step has a deadline of APRS_TIMEOUT. Nothing here waits: it reads the lines
+ * already received, checks the deadline and returns.
+ * - APRS_CONNECTING: the server banner arrived, queue the logon line.
+ * - APRS_LOGON_SENT: the logon line has been written, wait for the response.
+ * - APRS_AWAITING_LOGRESP: "# logresp ... verified" completes the logon.
  *
- * @return true if logon is verified, false if unverified or if the operation times out.
+ * An unverified logon cannot send messages, so it is treated as a failure.
  */
-bool verifyLogonStatus() {
-    unsigned long timeout = millis() + APRS_TIMEOUT;
-    while (millis() < timeout) {
-        String response;
-        if (readAPRSPacket(response)) {
-            // Look for the logon response line
-            if (response.startsWith("# logresp")) {
-                if (response.indexOf("verified") != -1 && response.indexOf("unverified") == -1) {
-                    DEBUG_PRINTLN(F("Logon verified"));
-                    return true;
-                } else if (response.indexOf("unverified") != -1) {
-                    DEBUG_PRINTLN(F("Logon unverified"));
-                    return false;
-                }
+void advanceLogon() {
+    if (!client.connected()) {
+        dropAPRSConnection(F("APRS connection lost during logon"), true);
+        return;
+    }
+    if (millis() - aprsStateStamp > APRS_TIMEOUT) {
+        metricsCount(METRIC_LOGON_TIMEOUT);
+        dropAPRSConnection(F("APRS logon timeout"), true);
+        return;
+    }
+
+    if (aprsState == APRS_LOGON_SENT) {
+        if (aprsTx.depth() == 0) {
+            setAPRSState(APRS_AWAITING_LOGRESP);
+        }
+        return;
+    }
+
+    APRSLine response;
+    while (readAPRSPacket(response)) {
+        if (aprsState == APRS_CONNECTING) {
+            if (response.text[0] == '#') { // server banner
+                DEBUG_PRINTLN(response.text);
+                performAPRSLogon();
+                setAPRSState(APRS_LOGON_SENT);
             }
+            return;
+        }
+
+        int logon = checkLogonResponse(response);
+        if (logon > 0) {
+            DEBUG_PRINTLN(F("Logon verified"));
+            metricsCount(METRIC_LOGON_VERIFIED);
+            aprsServers.recordLogon(aprsServerIndex, millis() - aprsStateStamp);
+            setAPRSState(APRS_VERIFIED);
+            return;
+        }
+        if (logon < 0) {
+            metricsCount(METRIC_LOGON_UNVERIFIED);
+            dropAPRSConnection(F("Logon unverified"), true);
+            return;
         }
-        yield();
     }
-    DEBUG_PRINTLN(F("Verification timeout"));
-    return false;
 }
 
 /**
@@ -402,42 +832,110 @@ bool verifyLogonStatus() {
  *
  * This function manages the APRS connection and data polling process by
  * transitioning through various states:
- * - If disconnected, attempts to establish a connection.
- * - If connected or logged in, verifies the logon status.
- * - If verified, polls APRS data.
+ * - If disconnected, attempts a connection every APRS_RETRY_INTERVAL once a
+ *   server is out of backoff, looking up its address a slice at a time.
+ * - While logging on, advances the handshake one step at a time.
+ * - If verified, polls APRS data, and after APRS_FILTER_BASELINE switches to
+ *   APRS_RUNTIME_FILTER in-band, then logs the byte rate under it one window later.
+ * Queued outbound lines are written on every call. No state waits for the
+ * server, so loop() keeps running during a slow handshake.
  *
  * The function relies on external state variables and helper functions:
  * - aprsState: Current state of the APRS connection.
- * - establishAPRSConnection(): Initiates connection to APRS.
- * - verifyLogonStatus(): Checks if logon is successful.
+ * - connectToAPRSserver(): Initiates connection to APRS.
+ * - resolveAPRSserver(): Looks up the server's address and connects.
+ * - advanceLogon(): Steps the logon handshake.
  * - pollAPRS(): Polls APRS data when verified.
  */
 void updateAPRS() {
+  MetricScope timing(METRIC_UPDATE_APRS);
+  serviceAPRSTx(); // drain the transmit queue
+
+  // a replay takes the place of the server until it ends
+  if (aprsReplayActive()) {
+    if (aprsState != APRS_DISCONNECTED) {
+      dropAPRSConnection(F("APRS replay started"), false);
+    }
+    pollAPRS();
+    return;
+  }
+
   // Update APRS data
   switch (aprsState) {
     case APRS_DISCONNECTED:
-      connectToAPRS();
-      break;
-      
-    case APRS_CONNECTED:  // Fall through
-    case APRS_LOGGED_IN:
-      if (verifyLogonStatus()) {
-        aprsState = APRS_VERIFIED;
+      if (millis() - aprsStateStamp >= APRS_RETRY_INTERVAL &&
+          aprsServers.nextRetry(millis()) == 0) {
+        connectToAPRSserver();
       }
       break;
-      
+
+    case APRS_RESOLVING:
+      resolveAPRSserver();
+      break;
+
+    case APRS_CONNECTING:  // Fall through
+    case APRS_LOGON_SENT:  // Fall through
+    case APRS_AWAITING_LOGRESP:
+      advanceLogon();
+      break;
+
     case APRS_VERIFIED:
       pollAPRS();
+      updateAPRSFilter(); // narrow the filter once the logon filter has been measured
       break;
   }
 } // updateAPRS()
 
 /**
- * @brief Attempts to establish a connection to the APRS server.
+ * @brief Sets the APRS-IS servers to use, in order of preference.
+ *
+ * Clears the health record of every server. Also useful to point the unit at
+ * local stand-in servers for testing.
+ *
+ * @param list  Endpoints; the array must stay valid while in use.
+ * @param count Entries in list.
+ */
+void setAPRSServers(const APRSEndpoint *list, int count) {
+    aprsServers.begin(list, count);
+}
+
+/**
+ * @brief Prepares the APRS-IS service; called once from setup() before any connection.
+ *
+ * Composes the constant packet prefixes and loads APRS_SERVERS into the server
+ * list, so the list is set before updateAPRS() asks it when to retry.
+ */
+void beginAPRS() {
+    buildAPRSHeaders();
+    setAPRSServers(APRS_SERVERS, sizeof(APRS_SERVERS) / sizeof(APRS_SERVERS[0]));
+}
+
+/**
+ * @brief Longest the TCP connect to a server may take.
  *
- * This function checks if the client is already connected to the APRS server.
- * If not connected, it attempts to connect using the specified server address and port.
- * Debug messages are printed to indicate the connection status.
+ * APRS_CONNECT_MARGIN times the server's usual connect time, at least
+ * APRS_CONNECT_MIN; APRS_CONNECT_TIMEOUT for a server not yet reached or
+ * whose last attempt failed.
+ */
+static unsigned long connectBudget(int index) {
+    const APRSEndpointHealth &health = aprsServers.health(index);
+    if (health.connectSamples == 0 || health.consecutive > 0) {
+        return APRS_CONNECT_TIMEOUT;
+    }
+    unsigned long budget = APRS_CONNECT_MARGIN * aprsServers.avgConnectMs(index);
+    if (budget < APRS_CONNECT_MIN) {
+        budget = APRS_CONNECT_MIN;
+    }
+    return (budget < APRS_CONNECT_TIMEOUT) ? budget : APRS_CONNECT_TIMEOUT;
+}
+
+/**
+ * @brief Opens the TCP connection to the server selected by connectToAPRSserver().
+ *
+ * Called once its name has been looked up, so the lookup in connect() is
+ * answered from the cache. The connect itself cannot be split across passes on
+ * this core; it blocks for at most connectBudget(). The connect time is
+ * recorded; a failure backs that server off with exponential delay and jitter.
  *
  * @return true if the client is already connected or the connection is successful, false otherwise.
  */
@@ -446,11 +944,23 @@ bool connectToAPRS() {
     if (client.connected()) {
         return true;
     }
-
-    if (client.connect(APRS_SERVER, APRS_PORT)) {
+    if (aprsServerIndex < 0) {
+        return false;
+    }
+    const APRSEndpoint &server = aprsServers.endpoint(aprsServerIndex);
+
+    unsigned long start = millis();
+    client.setTimeout(connectBudget(aprsServerIndex)); // bounds the blocking connect
+    if (client.connect(server.host, server.port)) {
+        aprsServers.recordConnect(aprsServerIndex, millis() - start);
+        aprsReader.reset(); // drop any partial line from the previous session
+        aprsTx.clear();     // and anything queued for it
+        aprsLastByteStamp = millis();
         DEBUG_PRINTLN(F("APRS connected"));
         return true;
     } else {
+        aprsServers.recordFailure(aprsServerIndex, millis(), random(0x7FFFFFFF));
+        metricsCount(METRIC_CONNECT_FAILED);
         DEBUG_PRINTLN(F("APRS connection failed."));
         return false;
     }
@@ -0,0 +1,134 @@
+/**
+ * @file aprsTxQueue.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Implementation of the APRS-IS transmit queue.
+ *
+ * Each slot holds one line already framed with CR LF. When nothing is being
+ * written, stage() copies the oldest lines that fit into the segment buffer;
+ * the lines stay in their slots until the whole segment has been written so
+ * depth and time in queue stay accurate while the connection is backed up.
+ */
+
+#include "aprsTxQueue.h"
+
+#include <string.h> // memcpy
+
+static_assert(APRS_TX_SEGMENT_SIZE >= APRS_TX_LINE_SIZE + 2, "a segment must hold the longest line");
+
+APRSTxQueue::APRSTxQueue()
+{
+	clear();
+}
+
+//! Drops all queued lines. Counters are kept.
+void APRSTxQueue::clear()
+{
+	_head = 0;
+	_count = 0;
+	_bytesPending = 0;
+	_segLength = 0;
+	_segSent = 0;
+	_segLines = 0;
+}
+
+/**
+ * @brief Copies a line into the queue and appends the terminator.
+ *
+ * @param line   Line text without terminator.
+ * @param length Characters in line, at most APRS_TX_LINE_SIZE.
+ * @param now    Current millis().
+ * @return false if the queue is full or the line too long; the line is dropped.
+ */
+bool APRSTxQueue::enqueue(const char *line, size_t length, unsigned long now)
+{
+	if (_count == APRS_TX_QUEUE_DEPTH || length > (size_t)APRS_TX_LINE_SIZE)
+	{
+		_stats.dropped++;
+		return false;
+	}
+
+	Slot &slot = _slots[(_head + _count) % APRS_TX_QUEUE_DEPTH];
+	memcpy(slot.text, line, length);
+	slot.text[length++] = '\r';
+	slot.text[length++] = '\n';
+	slot.length = (uint16_t)length;
+	slot.queuedAt = now;
+
+	_count++;
+	_bytesPending += length;
+	_stats.queued++;
+	if (_count > _stats.maxDepth)
+	{
+		_stats.maxDepth = _count;
+	}
+	return true;
+}
+
+/**
+ * @brief Copies as many whole queued lines as fit into the segment buffer.
+ *
+ * With APRS_TX_COALESCE_MS set, a lone line is held back until it is that old
+ * in case another line follows it.
+ *
+ * @return true if a segment was staged.
+ */
+bool APRSTxQueue::stage(unsigned long now)
+{
+	if (_count == 0)
+	{
+		return false;
+	}
+	if (_count == 1 && now - _slots[_head].queuedAt < APRS_TX_COALESCE_MS)
+	{
+		return false;
+	}
+
+	_segLength = 0;
+	_segSent = 0;
+	_segLines = 0;
+	while (_segLines < _count)
+	{
+		const Slot &slot = _slots[(_head + _segLines) % APRS_TX_QUEUE_DEPTH];
+		if (_segLength + slot.length > (size_t)APRS_TX_SEGMENT_SIZE)
+		{
+			break;
+		}
+		memcpy(_segment + _segLength, slot.text, slot.length);
+		_segLength += slot.length;
+		_segLines++;
+	}
+	return true;
+}
+
+//! Accounts for bytes written from the segment and retires its lines when complete.
+void APRSTxQueue::advance(size_t written, size_t left, unsigned long now)
+{
+	_segSent += written;
+	_bytesPending -= written;
+	_stats.bytesSent += written;
+	_stats.segments++;
+	if (written < left)
+	{
+		_stats.partialWrites++;
+		return;
+	}
+
+	for (int i = 0; i < _segLines; i++)
+	{
+		unsigned long waited = now - _slots[_head].queuedAt;
+		_stats.totalQueueMs += waited;
+		if (waited > _stats.maxQueueMs)
+		{
+			_stats.maxQueueMs = waited;
+		}
+		_head = (_head + 1) % APRS_TX_QUEUE_DEPTH;
+	}
+	_count -= _segLines;
+	_stats.sent += _segLines;
+	_segLength = 0;
+	_segSent = 0;
+	_segLines = 0;
+}
+
+// End of file
@@ -46,6 +46,10 @@ const String CALLSIGN = "W4KRL-2";			// call-SSID
 const String APRS_PASSCODE = "9092";		// https://aprs.do3sww.de/
 const String APRS_SOFTWARE_NAME = "SAGEBT"; // APRS ID for weather data
 const String APHORISM_FILE = "/aphorisms.txt";
+const String APHORISM_CORPUS = "/aphorisms.bin"; // compiled from APHORISM_FILE by build_corpus.py
 const String APRS_FILTER = "m/50"; // default value - Change to "b-your call-*"
+// narrower filter applied without reconnecting once the logon filter has run a while
+// g/ passes messages to CALLSIGN, b/ packets from it; "" keeps APRS_FILTER
+const String APRS_RUNTIME_FILTER = "g/" + CALLSIGN + " b/" + CALLSIGN;
 
 // End of file
@@ -18,6 +18,8 @@
 */
 #include <Arduino.h>           // Arduino functions
 #include "aphorismGenerator.h" // aphorism functions
+#include "aprsBulletins.h"     // scheduled APRS bulletins
+#include "aprsCapture.h"       // APRS-IS capture and replay
 #include "aprsService.h"       // APRS functions
 #include "credentials.h"       // account information
 #include "onetimeScreens.h"    // one-time screens
@@ -27,6 +29,7 @@
 #include "wifiConnection.h"    // Wi-Fi connection
 #include "wug_debug.h"         // debug print macro
 
+#ifndef PIO_UNIT_TESTING // test suites provide their own setup() and loop()
 /*
 ******************************************************
 ********************* SETUP **************************
@@ -39,8 +42,10 @@ void setup()
   splashScreen();        // display splash screen
   logonToRouter();       // connect to WiFi
   setTimeZone();         // set timezone using ezTime library
+  beginAPRS();           // compose the APRS packet prefixes and load the server list
   connectToAPRSserver(); // connect to APRS-IS server
   mountFS();             // mount LittleFS and prepare APRS bulletin file
+  beginAPRSCapture();    // start a capture or replay if one is built in
   startTasks();          // start scheduled tasks
 } // setup()
 
@@ -54,9 +59,10 @@ void loop()
   checkWiFiConnection(); // check Wi-Fi connection status
   events();              // ezTime events including autoconnect to NTP server
   updateTasks();         // update scheduled tasks
-  // processBulletins();        // process APRS bulletins
+  processBulletins();    // send scheduled APRS bulletins
   updateAPRS(); // update APRS data
 } // loop()
+#endif // PIO_UNIT_TESTING
 
 /*
 *******************************************************
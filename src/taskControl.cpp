@@ -8,6 +8,7 @@
  * - Fetching current and forecasted weather data.
  * - Posting weather data to APRS and ThingSpeak services.
  * - Updating sequential display frames and clock ticks.
+ * - Printing the APRS metrics to the serial port.
  *
  * Timers are instantiated using the TickTwo library and started in the `startTasks()` function, which should be called in the Arduino `setup()`.
  * The `updateTasks()` function should be called in the Arduino `loop()` to ensure timers are serviced and scheduled tasks are executed.
@@ -25,19 +26,23 @@
 
 #include <Arduino.h>	 // Arduino functions
 #include <TickTwo.h>	 // v4.4.0 Stefan Staub https://github.com/sstaub/TickTwo
+#include "aprsMetrics.h" // APRS metrics report
 #include "aprsService.h" // APRS functions
 
 //! Instantiate the scheduled tasks
 TickTwo tmrAPRSticker(pollAPRS, 5000, MILLIS); // APRS bulletin ticker
+TickTwo tmrMetricsReport(reportAPRSMetrics, 600000, 0, MILLIS); // APRS metrics every 10 minutes
 
 //! Start the TickTwo timers in setup()
 void startTasks()
 {
 	tmrAPRSticker.start(); // start APRS ticker
+	tmrMetricsReport.start(); // start metrics report
 } // startTasks()
 
 //! Update the TickTwo timers in loop()
 void updateTasks()
 {
 	tmrAPRSticker.update(); // update APRS ticker
+	tmrMetricsReport.update(); // update metrics report
 } // updateTasks()
\ No newline at end of file
@@ -0,0 +1,544 @@
+/**
+ * @file test_main.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Cost of the outbound APRS formatters and the aphorism picker.
+ *
+ * Times APRSformatBulletin(), APRSpadder(), APRSpadCall(), APRSlocation(),
+ * the logon line, readAphorismLine() and pickAphorism() over data/aphorisms.txt (and the packed
+ * data/aphorisms.bin when build_corpus.py has made it) next to the same
+ * records read from flash with flashAphorism(), and counts the
+ * heap allocations each one makes. The String formatters are measured next
+ * to the APRSbuild...() functions that fill an APRSPacketBuilder, which is
+ * what the transmit path uses and should not allocate at all. The aphorism
+ * rotation, its checkpoints and splitAPRSText() are timed too; their
+ * tests are in test_aphorism_rotation, test_aphorism_checkpoint and
+ * test_aprs_multipart. Every result is printed for reading and
+ * as one JSON object per line prefixed "BENCH " for scripts; set
+ * APRS_BENCH_JSON to a file name to also append the JSON lines there, so runs
+ * of different firmware versions can be compared.
+ * Host only, on the stand-ins in lib/sim: pio test -e native -f bench_aprs_format
+ *
+ * Allocation counts come from the host String, which keeps up to 15
+ * characters without the heap; the ESP8266 String keeps up to 10, so short
+ * results may allocate on the device where they do not here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+#include <unity.h>
+#include <LittleFS.h>
+#include <sim.h>
+#include <unistd.h>
+#include "aphorismCheckpoint.h"
+#include "aphorismFlash.h"
+#include "aphorismGenerator.h"
+#include "aphorismRotation.h"
+#include "aprsMultipart.h"
+#include "aprsParser.h"
+#include "aprsService.h"
+#include "credentials.h"
+
+static unsigned long allocCount = 0; // operator new calls
+static unsigned long allocBytes = 0; // bytes requested from operator new
+
+//! Counts and makes one allocation; every replaced operator new comes here
+//! and every operator delete goes to free(), so each pair matches.
+static void *countedAlloc(size_t size, size_t align)
+{
+	allocCount++;
+	allocBytes += size;
+	size = size ? size : 1;
+	if (align <= alignof(max_align_t))
+	{
+		return malloc(size);
+	}
+	return aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+static void *countedNew(size_t size, size_t align)
+{
+	void *p = countedAlloc(size, align);
+	if (p == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void *operator new(size_t size) { return countedNew(size, 0); }
+void *operator new[](size_t size) { return countedNew(size, 0); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size, 0); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size, 0); }
+void *operator new(size_t size, std::align_val_t align) { return countedNew(size, (size_t)align); }
+void *operator new[](size_t size, std::align_val_t align) { return countedNew(size, (size_t)align); }
+void *operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return countedAlloc(size, (size_t)align); }
+void *operator new[](size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return countedAlloc(size, (size_t)align); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { free(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { free(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { free(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { free(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { free(p); }
+
+static uint64_t benchNanos()
+{
+	using namespace std::chrono;
+	return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static const unsigned long ROUNDS = 200000;
+static volatile size_t sink = 0; // keeps results from being optimised away
+
+//! Weather values in the ranges APRSpadder() formats, with their widths
+static const struct
+{
+	float value;
+	int width;
+} PADDER_INPUTS[] = {
+	{77.4f, 3}, {220.0f, 3}, {4.6f, 3}, {0.0f, 3}, {50.2f, 2}, {9900.0f, 5}, {-3.7f, 3}, {12.5f, 3},
+};
+static const size_t PADDER_COUNT = sizeof(PADDER_INPUTS) / sizeof(PADDER_INPUTS[0]);
+
+static const char *const CALLS[] = {"W4KRL-2", "KD4AAA", "N3ABC-13", "KC2XYZ-9", "W4ABC", "WB4BBB-7", "BLN1", "VERYLONGCALL-15"};
+static const size_t CALL_COUNT = sizeof(CALLS) / sizeof(CALLS[0]);
+
+static const struct
+{
+	float lat;
+	float lon;
+} LOCATIONS[] = {
+	{38.9100f, -77.0340f}, {39.0367f, -76.9722f}, {-33.8688f, 151.2093f}, {51.5074f, -0.1278f}, {0.0f, 0.0f}, {64.8378f, -147.7164f},
+};
+static const size_t LOCATION_COUNT = sizeof(LOCATIONS) / sizeof(LOCATIONS[0]);
+
+static const char *const MESSAGES[] = {
+	"Net tonight at 2000 on the 2m repeater",
+	"A smooth sea never made a skilled sailor.",
+	"He who hesitates is lost.",
+	"Measure twice, cut once; then measure again because the saw drifted a little.",
+};
+static const size_t MESSAGE_COUNT = sizeof(MESSAGES) / sizeof(MESSAGES[0]);
+
+/**
+ * @brief Prints a result as text and as a JSON line, and appends the JSON
+ * line to $APRS_BENCH_JSON when it is set.
+ */
+static void report(const char *name, unsigned long ops, uint64_t nanos, unsigned long allocs, unsigned long bytes)
+{
+	double nsPerOp = (double)nanos / ops;
+	double allocsPerOp = (double)allocs / ops;
+	double bytesPerOp = (double)bytes / ops;
+	printf("%-20s %9lu ops %10.1f ns/op %6.2f allocs/op %8.1f bytes/op\n",
+		   name, ops, nsPerOp, allocsPerOp, bytesPerOp);
+
+	char json[256];
+	snprintf(json, sizeof(json),
+			 "{\"bench\":\"%s\",\"firmware\":\"%s\",\"ops\":%lu,\"ns_per_op\":%.1f,"
+			 "\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f}",
+			 name, FW_VERSION.c_str(), ops, nsPerOp, allocsPerOp, bytesPerOp);
+	printf("BENCH %s\n", json);
+
+	const char *path = getenv("APRS_BENCH_JSON");
+	if (path != nullptr)
+	{
+		FILE *out = fopen(path, "a");
+		if (out != nullptr)
+		{
+			fprintf(out, "%s\n", json);
+			fclose(out);
+		}
+	}
+}
+
+/**
+ * @brief Runs body(i) for i in [0, ops) and reports its time and allocations.
+ */
+template <typename Body>
+static void runBench(const char *name, unsigned long ops, Body body)
+{
+	unsigned long allocs = allocCount;
+	unsigned long bytes = allocBytes;
+	uint64_t start = benchNanos();
+	for (unsigned long i = 0; i < ops; i++)
+	{
+		body(i);
+	}
+	uint64_t elapsed = benchNanos() - start;
+	report(name, ops, elapsed, allocCount - allocs, allocBytes - bytes);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void bench_format_bulletin()
+{
+	runBench("APRSformatBulletin", ROUNDS, [](unsigned long i)
+			 {
+		String bulletin = APRSformatBulletin(MESSAGES[i % MESSAGE_COUNT], (i & 1) ? "M" : "E");
+		sink += bulletin.length(); });
+
+	String bulletin = APRSformatBulletin(MESSAGES[1], "M");
+	TEST_ASSERT_EQUAL_STRING("W4KRL-2>APRS,TCPIP*::BLNM     :A smooth sea never made a skilled sailor.", bulletin.c_str());
+}
+
+void bench_build_bulletin()
+{
+	static APRSPacketBuilder packet;
+	runBench("APRSbuildBulletin", ROUNDS, [](unsigned long i)
+			 {
+		APRSbuildBulletin(packet, MESSAGES[i % MESSAGE_COUNT], (i & 1) ? "M" : "E");
+		sink += packet.length(); });
+
+	TEST_ASSERT_TRUE(APRSbuildBulletin(packet, MESSAGES[1], "M"));
+	TEST_ASSERT_EQUAL_STRING("W4KRL-2>APRS,TCPIP*::BLNM     :A smooth sea never made a skilled sailor.", packet.c_str());
+	TEST_ASSERT_FALSE(APRSbuildBulletin(packet, MESSAGES[1], "MM"));
+	char tooLong[APRS_MESSAGE_MAX + 2];
+	memset(tooLong, 'x', sizeof(tooLong) - 1);
+	tooLong[sizeof(tooLong) - 1] = '\0';
+	TEST_ASSERT_FALSE(APRSbuildBulletin(packet, tooLong, "M"));
+	tooLong[APRS_MESSAGE_MAX] = '\0';
+	TEST_ASSERT_TRUE(APRSbuildBulletin(packet, tooLong, "M"));
+}
+
+void bench_build_ack()
+{
+	static APRSPacketBuilder packet;
+	runBench("APRSbuildAck", ROUNDS, [](unsigned long i)
+			 {
+		APRSbuildAck(packet, CALLS[i % (CALL_COUNT - 1)], "42");
+		sink += packet.length(); });
+
+	TEST_ASSERT_TRUE(APRSbuildAck(packet, "KD4AAA", "42"));
+	TEST_ASSERT_EQUAL_STRING("W4KRL-2>APRS,TCPIP*::KD4AAA   :ack42", packet.c_str());
+	TEST_ASSERT_FALSE(APRSbuildAck(packet, "KD4AAA", "123456"));
+	TEST_ASSERT_FALSE(APRSbuildAck(packet, "VERYLONGCALL-15", "42"));
+}
+
+void bench_build_message()
+{
+	static APRSPacketBuilder packet;
+	runBench("APRSbuildMessage", ROUNDS, [](unsigned long i)
+			 {
+		APRSbuildMessage(packet, CALLS[i % (CALL_COUNT - 1)], MESSAGES[i % (MESSAGE_COUNT - 1)]);
+		sink += packet.length(); });
+
+	TEST_ASSERT_TRUE(APRSbuildMessage(packet, "KD4AAA", MESSAGES[2]));
+	TEST_ASSERT_EQUAL_STRING("W4KRL-2>APRS,TCPIP*::KD4AAA   :He who hesitates is lost.", packet.c_str());
+	TEST_ASSERT_FALSE(APRSbuildMessage(packet, "KD4AAA", MESSAGES[3])); // 77 characters
+}
+
+void bench_padder()
+{
+	runBench("APRSpadder", ROUNDS, [](unsigned long i)
+			 {
+		String padded = APRSpadder(PADDER_INPUTS[i % PADDER_COUNT].value, PADDER_INPUTS[i % PADDER_COUNT].width);
+		sink += padded.length(); });
+
+	TEST_ASSERT_EQUAL_STRING("077", APRSpadder(77.4f, 3).c_str());
+	TEST_ASSERT_EQUAL_STRING("09900", APRSpadder(9900.0f, 5).c_str());
+	TEST_ASSERT_EQUAL_STRING("", APRSpadder(1000.0f, 3).c_str()); // does not fit the field
+}
+
+void bench_pad_call()
+{
+	runBench("APRSpadCall", ROUNDS, [](unsigned long i)
+			 {
+		String padded = APRSpadCall(CALLS[i % CALL_COUNT]);
+		sink += padded.length(); });
+
+	TEST_ASSERT_EQUAL_STRING("W4KRL-2  ", APRSpadCall("W4KRL-2").c_str());
+	TEST_ASSERT_EQUAL_STRING("VERYLONGC", APRSpadCall("VERYLONGCALL-15").c_str());
+}
+
+void bench_location()
+{
+	runBench("APRSlocation", ROUNDS, [](unsigned long i)
+			 {
+		String location = APRSlocation(LOCATIONS[i % LOCATION_COUNT].lat, LOCATIONS[i % LOCATION_COUNT].lon);
+		sink += location.length(); });
+
+	TEST_ASSERT_EQUAL_STRING("3854.60N/07702.04W", APRSlocation(38.9100f, -77.0340f).c_str());
+}
+
+void bench_logon()
+{
+	setAPRSFilter(APRS_FILTER.c_str());
+	runBench("APRSlogonString", ROUNDS, [](unsigned long)
+			 {
+		String logon = APRSlogonString();
+		sink += logon.length(); });
+
+	String expected = "user " + CALLSIGN + " pass " + APRS_PASSCODE + " ver " + APRS_SOFTWARE_NAME + " " + FW_VERSION + " filter " + APRS_FILTER;
+	TEST_ASSERT_EQUAL_STRING(expected.c_str(), APRSlogonString().c_str());
+}
+
+void bench_build_logon()
+{
+	static APRSPacketBuilder packet;
+	setAPRSFilter(APRS_FILTER.c_str());
+	runBench("APRSbuildLogon", ROUNDS, [](unsigned long)
+			 {
+		APRSbuildLogon(packet);
+		sink += packet.length(); });
+
+	TEST_ASSERT_TRUE(APRSbuildLogon(packet));
+	TEST_ASSERT_EQUAL_STRING(APRSlogonString().c_str(), packet.c_str());
+}
+
+//! Copies a file between the host directories behind LittleFS.
+static bool copyHostFile(const char *from, const char *to)
+{
+	FILE *in = fopen(from, "rb");
+	FILE *out = in ? fopen(to, "wb") : nullptr;
+	char buf[512];
+	size_t n;
+	while (out && (n = fread(buf, 1, sizeof(buf), in)) > 0)
+	{
+		fwrite(buf, 1, n, out);
+	}
+	if (in)
+	{
+		fclose(in);
+	}
+	return out != nullptr && fclose(out) == 0;
+}
+
+void bench_pick_aphorism()
+{
+	if (!LittleFS.begin() || !LittleFS.exists(APHORISM_FILE.c_str()))
+	{
+		TEST_IGNORE_MESSAGE("data/aphorisms.txt not found, run from the project directory");
+	}
+
+	// mount a copy so the index sidecar is not written into data/, and keep a
+	// second copy under another name that readAphorismLine() scans line by line
+	static char root[] = "/tmp/bench_aphorismsXXXXXX";
+	TEST_ASSERT_NOT_NULL(mkdtemp(root));
+	String source = String(simOptions.fsRoot) + APHORISM_FILE;
+	String corpus = String(root) + APHORISM_FILE;
+	String scanned = String(root) + "/scanned.txt";
+	String sidecar = corpus + ".idx";
+	TEST_ASSERT_TRUE(copyHostFile(source.c_str(), corpus.c_str()));
+	TEST_ASSERT_TRUE(copyHostFile(source.c_str(), scanned.c_str()));
+	const char *savedRoot = simOptions.fsRoot;
+	simOptions.fsRoot = root;
+
+	runBench("mountFS, index built", 1, [](unsigned long)
+			 { mountFS(); });
+	int lines = lineCount;
+	TEST_ASSERT_GREATER_THAN(0, lines);
+	TEST_ASSERT_TRUE(LittleFS.exists("/aphorisms.txt.idx"));
+	runBench("mountFS, index loaded", 1, [](unsigned long)
+			 { mountFS(); });
+	TEST_ASSERT_EQUAL_INT(lines, lineCount);
+
+	// every line in a scattered order: the index must give the same lines as the scan
+	for (int i = 0; i < lines; i++)
+	{
+		int line = (int)(((long)i * 7919) % lines);
+		TEST_ASSERT_EQUAL_STRING(readAphorismLine("/scanned.txt", line).c_str(), readAphorismLine(APHORISM_FILE, line).c_str());
+	}
+	TEST_ASSERT_EQUAL_STRING("", readAphorismLine(APHORISM_FILE, lines).c_str());
+	TEST_ASSERT_EQUAL_STRING("", readAphorismLine("/scanned.txt", lines).c_str()); // one scan, then gives up
+
+	runBench("readAphorismLine, indexed", (unsigned long)lines, [lines](unsigned long i)
+			 {
+		String aphorism = readAphorismLine(APHORISM_FILE, (int)((i * 7919) % lines));
+		sink += aphorism.length(); });
+	runBench("readAphorismLine, scanned", (unsigned long)lines, [lines](unsigned long i)
+			 {
+		String aphorism = readAphorismLine("/scanned.txt", (int)((i * 7919) % lines));
+		sink += aphorism.length(); });
+
+	// the packed corpus, if build_corpus.py has made one: clean ASCII records
+	// that fit the multi-part limit
+	String packedSource = String(savedRoot) + APHORISM_CORPUS;
+	String packed = String(root) + APHORISM_CORPUS;
+	if (copyHostFile(packedSource.c_str(), packed.c_str()))
+	{
+		runBench("mountFS, packed corpus", 1, [](unsigned long)
+				 { mountFS(); });
+		int records = lineCount;
+		TEST_ASSERT_GREATER_THAN(0, records);
+		TEST_ASSERT_TRUE(records <= lines);
+		for (int line = 0; line < records; line++)
+		{
+			String aphorism = readAphorismLine(APHORISM_FILE, line);
+			TEST_ASSERT_TRUE(aphorism.length() > 0 && aphorism.length() <= (unsigned)APRS_MULTIPART_TEXT_MAX);
+			for (unsigned k = 0; k < aphorism.length(); k++)
+			{
+				TEST_ASSERT_TRUE(aphorism[k] >= ' ' && aphorism[k] <= '~');
+			}
+			TEST_ASSERT_EQUAL_STRING(aphorism.c_str(), flashAphorism(line).c_str());
+		}
+		runBench("readAphorismLine, packed", (unsigned long)records, [records](unsigned long i)
+				 {
+			String aphorism = readAphorismLine(APHORISM_FILE, (int)((i * 7919) % records));
+			sink += aphorism.length(); });
+		// the records have no duplicates, so one cycle of picks gives each once
+		char *picked = new char[records]();
+		runBench("pickAphorism, packed", (unsigned long)records, [](unsigned long)
+				 {
+			String aphorism = pickAphorism(APHORISM_FILE);
+			sink += aphorism.length(); });
+		for (int line = 0; line < records; line++)
+		{
+			String aphorism = pickAphorism(APHORISM_FILE);
+			int k = 0;
+			while (k < records && flashAphorism(k) != aphorism)
+			{
+				k++;
+			}
+			TEST_ASSERT_TRUE(k < records && !picked[k]);
+			picked[k] = 1;
+		}
+		delete[] picked;
+		remove(packed.c_str());
+	}
+	else
+	{
+		printf("%s not found, run build_corpus.py to time the packed corpus\n", packedSource.c_str());
+	}
+
+	// the same records compiled into flash, read without LittleFS
+	int records = flashAphorismCount();
+	TEST_ASSERT_GREATER_THAN(0, records);
+	TEST_ASSERT_EQUAL_STRING("", flashAphorism(records).c_str());
+	runBench("flashAphorism", (unsigned long)records, [records](unsigned long i)
+			 {
+		String aphorism = flashAphorism((int)((i * 7919) % records));
+		sink += aphorism.length(); });
+	runBench("readFlashAphorism", (unsigned long)records, [records](unsigned long i)
+			 {
+		char text[APRS_MULTIPART_TEXT_MAX + 1];
+		sink += readFlashAphorism((int)((i * 7919) % records), text, sizeof(text)); });
+
+	// a packed record of the longest text the loader accepts is read whole
+	FILE *handMade = fopen(packed.c_str(), "wb");
+	TEST_ASSERT_NOT_NULL(handMade);
+	const uint8_t longest = 200, shortest = 3;
+	const uint32_t header[3] = {0x31435041, 12 + 3 * 2 + 1 + longest + 1 + shortest, 2}; // "APC1"
+	const uint16_t offsets[3] = {18, 18 + 1 + longest, 18 + 1 + longest + 1 + shortest};
+	fwrite(header, sizeof(header), 1, handMade);
+	fwrite(offsets, sizeof(offsets), 1, handMade);
+	fputc(longest, handMade);
+	for (int k = 0; k < longest; k++)
+	{
+		fputc('a' + k % 26, handMade);
+	}
+	fputc(shortest, handMade);
+	fputs("end", handMade);
+	fclose(handMade);
+	mountFS();
+	TEST_ASSERT_EQUAL_INT(2, lineCount);
+	TEST_ASSERT_EQUAL_UINT32(longest, readAphorismLine(APHORISM_FILE, 0).length());
+	TEST_ASSERT_EQUAL_STRING("end", readAphorismLine(APHORISM_FILE, 1).c_str());
+	remove(packed.c_str());
+
+	simOptions.fsRoot = savedRoot;
+	remove(corpus.c_str());
+	remove(scanned.c_str());
+	remove(sidecar.c_str());
+	rmdir(root);
+}
+
+void bench_aphorism_rotation()
+{
+	AphorismRotation rotation;
+	startAphorismRotation(rotation, 514, 12345);
+	runBench("nextAphorismIndex", ROUNDS, [&rotation](unsigned long i)
+			 { sink += nextAphorismIndex(rotation, (uint32_t)i); });
+	printf("rotation state: %u bytes\n", (unsigned)sizeof(AphorismRotation));
+}
+
+void bench_aphorism_checkpoint()
+{
+	static char root[] = "/tmp/bench_rotationXXXXXX";
+	TEST_ASSERT_NOT_NULL(mkdtemp(root));
+	const char *savedRoot = simOptions.fsRoot;
+	simOptions.fsRoot = root;
+	uint32_t cleared[4] = {0, 0, 0, 0};
+
+	AphorismRotation rotation;
+	AphorismRotation restored;
+	ESP.rtcUserMemoryWrite(APHORISM_RTC_OFFSET, cleared, sizeof(cleared));
+	restoreAphorismRotation(restored, 514);
+	startAphorismRotation(rotation, 514, 4242);
+	runBench("saveAphorismRotation", 64 * APHORISM_CHECKPOINT_PICKS * 4, [&rotation](unsigned long)
+			 {
+		sink += nextAphorismIndex(rotation, 7);
+		saveAphorismRotation(rotation); });
+	runBench("restoreAphorismRotation, RTC", 1000, [&restored](unsigned long)
+			 { sink += restoreAphorismRotation(restored, 514); });
+	ESP.rtcUserMemoryWrite(APHORISM_RTC_OFFSET, cleared, sizeof(cleared));
+	runBench("restoreAphorismRotation, log", 1, [&restored](unsigned long)
+			 { sink += restoreAphorismRotation(restored, 514); });
+
+	LittleFS.remove("/rotation.log");
+	simOptions.fsRoot = savedRoot;
+	rmdir(root);
+}
+
+void bench_split_aphorisms()
+{
+	if (!LittleFS.begin() || !LittleFS.exists(APHORISM_FILE.c_str()))
+	{
+		TEST_IGNORE_MESSAGE("data/aphorisms.txt not found, run from the project directory");
+	}
+
+	static char lines[600][APRS_MULTIPART_TEXT_MAX + 1];
+	int count = 0;
+	int split = 0;
+	File file = LittleFS.open(APHORISM_FILE.c_str(), "r");
+	while (file.available() && count < 600)
+	{
+		String line = file.readStringUntil('\n');
+		line.trim();
+		if (line.length() == 0 || line.length() > (unsigned)APRS_MULTIPART_TEXT_MAX)
+		{
+			continue;
+		}
+		strcpy(lines[count], line.c_str());
+
+		APRSTextPart parts[APRS_MULTIPART_PARTS_MAX];
+		split += (splitAPRSText(line.c_str(), line.length(), parts, APRS_MULTIPART_PARTS_MAX) > 1);
+		count++;
+	}
+	file.close();
+	printf("%d of %d aphorisms need more than one message\n", split, count);
+
+	runBench("splitAPRSText", (unsigned long)count * 100, [count](unsigned long i)
+			 {
+		APRSTextPart parts[APRS_MULTIPART_PARTS_MAX];
+		const char *line = lines[i % count];
+		sink += splitAPRSText(line, strlen(line), parts, APRS_MULTIPART_PARTS_MAX); });
+}
+
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(bench_format_bulletin);
+	RUN_TEST(bench_build_bulletin);
+	RUN_TEST(bench_build_ack);
+	RUN_TEST(bench_build_message);
+	RUN_TEST(bench_padder);
+	RUN_TEST(bench_pad_call);
+	RUN_TEST(bench_location);
+	RUN_TEST(bench_logon);
+	RUN_TEST(bench_build_logon);
+	RUN_TEST(bench_pick_aphorism);
+	RUN_TEST(bench_aphorism_rotation);
+	RUN_TEST(bench_aphorism_checkpoint);
+	RUN_TEST(bench_split_aphorisms);
+	return UNITY_END();
+}
@@ -0,0 +1,151 @@
+/**
+ * @file test_main.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Throughput benchmark for the TNC2 packet parser.
+ *
+ * Parses a mix of packets shaped like an m/50 feed and reports parsed packets
+ * per second, then runs the same feed through the addressee fast path.
+ * Runs natively (pio test -e native -f bench_aprs_parser) or on the D1 mini
+ * (pio test -e d1_mini -f bench_aprs_parser) for the real figure.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "aprsParser.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+static unsigned long benchMicros() { return micros(); }
+#else
+#include <chrono>
+static unsigned long benchMicros()
+{
+	using namespace std::chrono;
+	return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#ifdef ARDUINO
+static const unsigned long ROUNDS = 200;
+#else
+static const unsigned long ROUNDS = 50000;
+#endif
+
+//! Rough packet rate of the full APRS-IS feed, for scale
+static const unsigned long FULL_FEED_PKTS_PER_SEC = 150;
+
+static const char *const FEED[] = {
+	"KC2XYZ-9>APDR16,TCPIP*,qAC,T2TEXAS:=3854.61N/07702.04W[/A=000318 on the road",
+	"N3ABC-13>APRS,WIDE1-1,WIDE2-1,qAR,W4KRL-10:!3902.20N/07658.33W#PHG5360 digi",
+	"W4ABC>APN391,TCPIP*,qAC,T2CAN:_10090556c220s004g005t077r000p000P000h50b09900wRSW",
+	"K4QQQ-1>APMI06,TCPIP*,qAS,K4QQQ:T#005,199,000,255,073,123,01101001",
+	"KD4AAA>APRS,TCPIP*,qAC,T2SYDNEY::W4KRL-2  :What is the word today?{42",
+	"WB4BBB-7>APK102,WIDE1-1,qAR,N4CCC-3:>Monitoring 146.520",
+	"KB3DDD>APWW11,TCPIP*,qAC,T2BC::BLN1     :Net tonight at 2000 on the 2m repeater",
+	"N0EEE-5>APDR16,TCPIP*,qAC,T2USANW::KB3DDD   :ack17",
+	"AA4FFF>APRS,TCPIP*,qAC,T2NUK:?APRST",
+	"W3GGG-10>APNU3B,WIDE2-1,qAR,W3HHH-1:!3857.22NS07703.42W#PHG7360/W3,MDn Silver Spring",
+};
+static const size_t FEED_SIZE = sizeof(FEED) / sizeof(FEED[0]);
+
+void setUp() {}
+void tearDown() {}
+
+void bench_parse_throughput()
+{
+	size_t lengths[FEED_SIZE];
+	for (size_t i = 0; i < FEED_SIZE; i++)
+	{
+		lengths[i] = strlen(FEED[i]);
+	}
+
+	APRSPacket packet;
+	unsigned long parsed = 0;
+	unsigned long messages = 0;
+	unsigned long start = benchMicros();
+	for (unsigned long round = 0; round < ROUNDS; round++)
+	{
+		for (size_t i = 0; i < FEED_SIZE; i++)
+		{
+			if (parseAPRSPacket(FEED[i], lengths[i], packet))
+			{
+				parsed++;
+				messages += (packet.type == APRS_TYPE_MESSAGE);
+			}
+		}
+	}
+	unsigned long elapsed = benchMicros() - start;
+	if (elapsed == 0)
+	{
+		elapsed = 1;
+	}
+
+	double pps = parsed * 1e6 / elapsed;
+	printf("parser: %lu packets in %lu us, %.0f packets/s, %.1fx full feed\n",
+		   parsed, elapsed, pps, pps / FULL_FEED_PKTS_PER_SEC);
+
+	TEST_ASSERT_EQUAL_UINT32(ROUNDS * FEED_SIZE, parsed);
+	TEST_ASSERT_EQUAL_UINT32(ROUNDS * 3, messages);
+}
+
+void bench_fast_reject_throughput()
+{
+	size_t lengths[FEED_SIZE];
+	for (size_t i = 0; i < FEED_SIZE; i++)
+	{
+		lengths[i] = strlen(FEED[i]);
+	}
+
+	APRSPacket packet;
+	unsigned long rejected = 0;
+	unsigned long parsed = 0;
+	unsigned long start = benchMicros();
+	for (unsigned long round = 0; round < ROUNDS; round++)
+	{
+		for (size_t i = 0; i < FEED_SIZE; i++)
+		{
+			if (!aprsIsAddressedTo(FEED[i], lengths[i], "W4KRL-2  "))
+			{
+				rejected++;
+			}
+			else if (parseAPRSPacket(FEED[i], lengths[i], packet))
+			{
+				parsed++;
+			}
+		}
+	}
+	unsigned long elapsed = benchMicros() - start;
+	if (elapsed == 0)
+	{
+		elapsed = 1;
+	}
+
+	double pps = (rejected + parsed) * 1e6 / elapsed;
+	printf("fast path: %lu rejected, %lu parsed in %lu us, %.0f packets/s, %.1fx full feed\n",
+		   rejected, parsed, elapsed, pps, pps / FULL_FEED_PKTS_PER_SEC);
+
+	TEST_ASSERT_EQUAL_UINT32(ROUNDS, parsed);
+	TEST_ASSERT_EQUAL_UINT32(ROUNDS * (FEED_SIZE - 1), rejected);
+}
+
+#ifdef ARDUINO
+void setup()
+{
+	delay(2000); // let the serial monitor attach
+	UNITY_BEGIN();
+	RUN_TEST(bench_parse_throughput);
+	RUN_TEST(bench_fast_reject_throughput);
+	UNITY_END();
+}
+void loop() {}
+#else
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(bench_parse_throughput);
+	RUN_TEST(bench_fast_reject_throughput);
+	return UNITY_END();
+}
+#endif
@@ -0,0 +1,335 @@
+/**
+ * @file test_main.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Offline throughput benchmark over a captured APRS-IS stream.
+ *
+ * Replays a capture with startAPRSReplay() and pollAPRS(), so every line takes
+ * the firmware's own path: line reader, addressee fast path, parser, duplicate
+ * table, responder and transmit queue. The client is connected to a loopback
+ * socket that the benchmark drains, standing in for the server. Set
+ * APRS_REPLAY_CAPTURE to a capture copied off the device (see aprsCapture.h)
+ * to measure real traffic; without it a synthetic m/50-shaped capture is
+ * generated.
+ * Host only: pio test -e native -f bench_aprs_replay
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unity.h>
+#include <ESP8266WiFi.h>
+#include "aphorismGenerator.h"
+#include "aprsCapture.h"
+#include "aprsLineReader.h"
+#include "aprsMultipart.h"
+#include "aprsReplay.h"
+#include "aprsResponder.h"
+#include "aprsService.h"
+#include "credentials.h"
+#include "sim.h"
+
+extern WiFiClient client; // aprsService.cpp
+
+static unsigned long benchMicros()
+{
+	using namespace std::chrono;
+	return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static const unsigned long SYNTHETIC_LINES = 200000;
+static const unsigned long SYNTHETIC_SPACING_MS = 7; // about 150 packets/s
+
+static const char *const FEED[] = {
+	"# aprsc 2.1.19-g730c5c0 16 Oct 2026 05:01:12 GMT T2TEXAS 10.0.0.1:14580",
+	"KC2XYZ-9>APDR16,TCPIP*,qAC,T2TEXAS:=3854.61N/07702.04W[/A=000318 on the road",
+	"N3ABC-13>APRS,WIDE1-1,WIDE2-1,qAR,W4KRL-10:!3902.20N/07658.33W#PHG5360 digi",
+	"W4ABC>APN391,TCPIP*,qAC,T2CAN:_10090556c220s004g005t077r000p000P000h50b09900wRSW",
+	"K4QQQ-1>APMI06,TCPIP*,qAS,K4QQQ:T#005,199,000,255,073,123,01101001",
+	"KD4AAA>APRS,TCPIP*,qAC,T2SYDNEY::W4KRL-2  :What is the word today?{", // ID added, each sent twice
+	"WB4BBB-7>APK102,WIDE1-1,qAR,N4CCC-3:>Monitoring 146.520",
+	"KB3DDD>APWW11,TCPIP*,qAC,T2BC::BLN1     :Net tonight at 2000 on the 2m repeater",
+	"N0EEE-5>APDR16,TCPIP*,qAC,T2USANW::KB3DDD   :ack17",
+	"W3GGG-10>APNU3B,WIDE2-1,qAR,W3HHH-1:!3857.22NS07703.42W#PHG7360/W3,MDn Silver Spring",
+};
+static const size_t FEED_SIZE = sizeof(FEED) / sizeof(FEED[0]);
+
+//! Backs an APRSReplaySource with a host file
+class StdioBacking
+{
+public:
+	explicit StdioBacking(FILE *file) : _file(file), _length(0), _used(0) {}
+
+	int available()
+	{
+		if (_used == _length)
+		{
+			_length = fread(_buf, 1, sizeof(_buf), _file);
+			_used = 0;
+		}
+		return (int)(_length - _used);
+	}
+
+	int read(uint8_t *buf, size_t size)
+	{
+		size_t n = (size_t)available();
+		n = (n < size) ? n : size;
+		memcpy(buf, _buf + _used, n);
+		_used += n;
+		return (int)n;
+	}
+
+private:
+	FILE *_file;
+	uint8_t _buf[4096];
+	size_t _length;
+	size_t _used;
+};
+
+static unsigned long fakeNow = 0;
+static unsigned long fakeClock() { return fakeNow; }
+
+//! Copies a host file, false if it cannot be read or written.
+static bool copyHostFile(const char *from, const char *to)
+{
+	FILE *in = fopen(from, "rb");
+	FILE *out = in ? fopen(to, "wb") : nullptr;
+	char buf[512];
+	size_t n;
+	while (out && (n = fread(buf, 1, sizeof(buf), in)) > 0)
+	{
+		fwrite(buf, 1, n, out);
+	}
+	if (in)
+	{
+		fclose(in);
+	}
+	if (out)
+	{
+		fclose(out);
+	}
+	return out != nullptr;
+}
+
+//! Copies APRS_REPLAY_CAPTURE to path, or writes a synthetic capture there.
+static bool writeCapture(const char *path)
+{
+	const char *capture = getenv("APRS_REPLAY_CAPTURE");
+	if (capture != nullptr)
+	{
+		printf("replay: %s\n", capture);
+		return copyHostFile(capture, path);
+	}
+
+	FILE *file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	for (unsigned long i = 0; i < SYNTHETIC_LINES; i++)
+	{
+		const char *line = FEED[i % FEED_SIZE];
+		fprintf(file, "%lu\t%s", 1000 + i * SYNTHETIC_SPACING_MS, line);
+		if (line[strlen(line) - 1] == '{')
+		{
+			fprintf(file, "%lu", (i / FEED_SIZE / 2) % 100000); // the second is a retry
+		}
+		fputc('\n', file);
+	}
+	return fclose(file) == 0;
+}
+
+/**
+ * @brief Connects the APRS client to a loopback listener.
+ *
+ * @return The listener's end of the connection, to be drained, or -1.
+ */
+static int connectSink()
+{
+	int listener = socket(AF_INET, SOCK_STREAM, 0);
+	struct sockaddr_in addr = {};
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	socklen_t length = sizeof(addr);
+	if (listener < 0 || bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+		listen(listener, 1) != 0 || getsockname(listener, (struct sockaddr *)&addr, &length) != 0 ||
+		!client.connect("127.0.0.1", ntohs(addr.sin_port)))
+	{
+		if (listener >= 0)
+		{
+			close(listener);
+		}
+		return -1;
+	}
+	int sink = accept(listener, nullptr, nullptr);
+	close(listener);
+	return sink;
+}
+
+//! Reads everything the firmware has sent so far, returns the lines in it.
+static unsigned long drainSink(int sink)
+{
+	char buf[4096];
+	unsigned long lines = 0;
+	ssize_t n;
+	while ((n = recv(sink, buf, sizeof(buf), MSG_DONTWAIT)) > 0)
+	{
+		for (ssize_t k = 0; k < n; k++)
+		{
+			lines += (buf[k] == '\n');
+		}
+	}
+	return lines;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void bench_replay_throughput()
+{
+	char root[] = "/tmp/bench_replayXXXXXX";
+	TEST_ASSERT_NOT_NULL(mkdtemp(root));
+	String corpus = String(root) + APHORISM_FILE;
+	String capture = String(root) + "/capture.log";
+	TEST_ASSERT_TRUE(copyHostFile((String(simOptions.fsRoot) + APHORISM_FILE).c_str(), corpus.c_str()));
+	TEST_ASSERT_TRUE(writeCapture(capture.c_str()));
+	const char *savedRoot = simOptions.fsRoot;
+	simOptions.fsRoot = root;
+	mountFS();
+
+	int sink = connectSink();
+	TEST_ASSERT_TRUE(sink >= 0);
+	TEST_ASSERT_TRUE(startAPRSReplay("/capture.log", true));
+
+	// one pass per capture spacing of firmware time; only pollAPRS() is timed
+	unsigned long sent = 0, passes = 0, elapsed = 0;
+	while (aprsReplayActive())
+	{
+		unsigned long start = benchMicros();
+		pollAPRS();
+		elapsed += benchMicros() - start;
+		sent += drainSink(sink);
+		simAdvance(SYNTHETIC_SPACING_MS * 1000UL);
+		passes++;
+	}
+	// replies still waiting for a multi-part slot when the capture ran out
+	for (int i = 0; i < 100 && responderStats.replies < responderStats.queries; i++)
+	{
+		serviceAPRSResponder();
+		serviceAPRSMultipart();
+		serviceAPRSTx();
+		sent += drainSink(sink);
+		simAdvance(APRS_MULTIPART_SPACING * 1000UL);
+	}
+	sent += drainSink(sink);
+	client.stop();
+	close(sink);
+	simOptions.fsRoot = savedRoot;
+	remove(capture.c_str());
+	remove(corpus.c_str());
+	remove((corpus + ".idx").c_str());
+	remove((String(root) + "/rotation.log").c_str());
+	rmdir(root);
+	if (elapsed == 0)
+	{
+		elapsed = 1;
+	}
+
+	unsigned long lines = aprsReader.linesRead();
+	printf("replay: %lu lines in %lu passes, %lu us in pollAPRS()\n", lines, passes, elapsed);
+	printf("replay: %.0f lines/s, %.0f packets/s, %.0f replies/s\n",
+		   lines * 1e6 / elapsed, aprsPacketsParsed * 1e6 / elapsed, responderStats.replies * 1e6 / elapsed);
+	printf("replay: %lu rejected, %lu parsed, %lu errors, %lu queries, %lu retries, %lu acks, %lu replies, %lu dropped\n",
+		   aprsFastRejected, aprsPacketsParsed, aprsParseErrors, responderStats.queries, responderStats.retries,
+		   responderStats.acks, responderStats.replies, responderStats.dropped);
+	printf("replay: %lu lines sent, %lu tx dropped, %lu texts refused, %lu replies deferred, mean latency %lu us\n",
+		   sent, aprsTx.stats().dropped, multipartStats.refused, responderStats.deferred,
+		   responderStats.queries ? responderStats.totalLatencyUs / responderStats.queries : 0);
+
+	TEST_ASSERT_TRUE(lines > 0);
+	TEST_ASSERT_EQUAL_UINT32(0, responderStats.dropped);
+	TEST_ASSERT_EQUAL_UINT32(0, aprsTx.stats().dropped);
+	TEST_ASSERT_EQUAL_UINT32(aprsTx.stats().sent, sent);
+	if (getenv("APRS_REPLAY_CAPTURE") == nullptr)
+	{
+		TEST_ASSERT_EQUAL_UINT32(SYNTHETIC_LINES, lines);
+		TEST_ASSERT_EQUAL_UINT32(SYNTHETIC_LINES / FEED_SIZE / 2, responderStats.retries);
+		TEST_ASSERT_EQUAL_UINT32(responderStats.queries, responderStats.replies);
+	}
+}
+
+void test_replay_real_time_pacing()
+{
+	FILE *file = tmpfile();
+	TEST_ASSERT_NOT_NULL(file);
+	fputs("5000\t# first\n5100\t# second\nnot a record\n5300\t# third\n", file);
+	rewind(file);
+
+	StdioBacking backing(file);
+	fakeNow = 70000;
+	APRSReplaySource<StdioBacking> source(backing, fakeClock, true);
+	APRSLineReader reader;
+	APRSLine line;
+
+	TEST_ASSERT_TRUE(reader.readLine(source, line));
+	TEST_ASSERT_EQUAL_STRING("# first", line.text);
+	TEST_ASSERT_FALSE(reader.readLine(source, line)); // second is 100 ms later
+	fakeNow += 99;
+	TEST_ASSERT_FALSE(reader.readLine(source, line));
+	fakeNow += 1;
+	TEST_ASSERT_TRUE(reader.readLine(source, line));
+	TEST_ASSERT_EQUAL_STRING("# second", line.text);
+	fakeNow += 200;
+	TEST_ASSERT_TRUE(reader.readLine(source, line));
+	TEST_ASSERT_EQUAL_STRING("# third", line.text);
+	TEST_ASSERT_FALSE(reader.readLine(source, line));
+	TEST_ASSERT_TRUE(source.finished());
+	TEST_ASSERT_EQUAL_UINT32(1, source.badRecords());
+	fclose(file);
+}
+
+void test_replay_stamp_goes_back()
+{
+	FILE *file = tmpfile();
+	TEST_ASSERT_NOT_NULL(file);
+	// a capture that spans a reboot: millis() starts again near 0
+	fputs("3600000\t# before\n3600500\t# last before\n200\t# after\n700\t# later\n", file);
+	rewind(file);
+
+	StdioBacking backing(file);
+	fakeNow = 1000;
+	APRSReplaySource<StdioBacking> source(backing, fakeClock, true);
+	APRSLineReader reader;
+	APRSLine line;
+
+	TEST_ASSERT_TRUE(reader.readLine(source, line));
+	TEST_ASSERT_EQUAL_STRING("# before", line.text);
+	fakeNow += 500;
+	TEST_ASSERT_TRUE(reader.readLine(source, line));
+	TEST_ASSERT_EQUAL_STRING("# last before", line.text);
+	fakeNow += 10;
+	TEST_ASSERT_TRUE(reader.readLine(source, line)); // earlier stamp: released at once
+	TEST_ASSERT_EQUAL_STRING("# after", line.text);
+	fakeNow += 499;
+	TEST_ASSERT_FALSE(reader.readLine(source, line)); // spaced from the new start
+	fakeNow += 1;
+	TEST_ASSERT_TRUE(reader.readLine(source, line));
+	TEST_ASSERT_EQUAL_STRING("# later", line.text);
+	TEST_ASSERT_FALSE(reader.readLine(source, line));
+	TEST_ASSERT_TRUE(source.finished());
+	fclose(file);
+}
+
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_replay_real_time_pacing);
+	RUN_TEST(test_replay_stamp_goes_back);
+	RUN_TEST(bench_replay_throughput);
+	return UNITY_END();
+}
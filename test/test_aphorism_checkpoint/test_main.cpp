@@ -0,0 +1,159 @@
+/**
+ * @file test_main.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Tests for the aphorism rotation checkpoints.
+ *
+ * Checks restoreAphorismRotation() after a reset (RTC user memory), after a
+ * power loss (the LittleFS log, skipped ahead and not going back on a second
+ * one), with a torn last record and with a corpus of another size, and that
+ * the log stays bounded and survives a power loss while it is started over.
+ * Host only, on the stand-ins in lib/sim with the file system in a temporary
+ * directory: pio test -e native -f test_aphorism_checkpoint
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <unity.h>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <sim.h>
+#include "aphorismCheckpoint.h"
+
+static const uint16_t CORPUS = 514; // aphorisms in the test corpus
+static const size_t RECORD = 16;	// bytes in a checkpoint record
+
+static char root[32];
+static const char *savedRoot = nullptr;
+static AphorismRotation rotation;
+static AphorismRotation restored;
+
+//! Forgets the RTC copy, as a power loss does.
+static void loseRTC()
+{
+	uint32_t cleared[4] = {0, 0, 0, 0};
+	ESP.rtcUserMemoryWrite(APHORISM_RTC_OFFSET, cleared, sizeof(cleared));
+}
+
+//! Makes and saves picks of the rotation.
+static void pick(int picks)
+{
+	for (int i = 0; i < picks; i++)
+	{
+		nextAphorismIndex(rotation, 7);
+		saveAphorismRotation(rotation);
+	}
+}
+
+static size_t logSize()
+{
+	File log = LittleFS.open("/rotation.log", "r");
+	size_t size = log ? log.size() : 0;
+	log.close();
+	return size;
+}
+
+void setUp()
+{
+	strcpy(root, "/tmp/test_rotationXXXXXX");
+	TEST_ASSERT_NOT_NULL(mkdtemp(root));
+	savedRoot = simOptions.fsRoot;
+	simOptions.fsRoot = root;
+	loseRTC();
+	restoreAphorismRotation(restored, CORPUS); // nothing there, starts the log interval over
+	startAphorismRotation(rotation, CORPUS, 4242);
+}
+
+void tearDown()
+{
+	LittleFS.remove("/rotation.log");
+	LittleFS.remove("/rotation.new");
+	simOptions.fsRoot = savedRoot;
+	rmdir(root);
+}
+
+void test_nothing_saved()
+{
+	TEST_ASSERT_EQUAL_INT(RESTORE_NONE, restoreAphorismRotation(restored, CORPUS));
+}
+
+void test_reset_restores_from_rtc()
+{
+	pick(100);
+	TEST_ASSERT_EQUAL_INT(RESTORE_RTC, restoreAphorismRotation(restored, CORPUS));
+	TEST_ASSERT_EQUAL_UINT32(rotation.seed, restored.seed);
+	TEST_ASSERT_EQUAL_INT(rotation.position, restored.position);
+}
+
+void test_power_loss_restores_from_log()
+{
+	pick(100);
+	loseRTC();
+	TEST_ASSERT_EQUAL_INT(RESTORE_LOG, restoreAphorismRotation(restored, CORPUS));
+	TEST_ASSERT_EQUAL_UINT32(rotation.seed, restored.seed);
+	TEST_ASSERT_TRUE(restored.position >= rotation.position); // goes on past where it was
+	TEST_ASSERT_TRUE(restored.position <= rotation.position + APHORISM_CHECKPOINT_PICKS);
+	uint16_t resumed = restored.position;
+
+	// a second power loss before the next record does not go back
+	TEST_ASSERT_EQUAL_INT(RESTORE_LOG, restoreAphorismRotation(restored, CORPUS));
+	TEST_ASSERT_TRUE(restored.position >= resumed);
+}
+
+void test_torn_record_skipped()
+{
+	pick(100);
+	loseRTC();
+	File log = LittleFS.open("/rotation.log", "a");
+	log.write((const uint8_t *)"torn record....", RECORD);
+	log.close();
+	TEST_ASSERT_EQUAL_INT(RESTORE_LOG, restoreAphorismRotation(restored, CORPUS));
+	TEST_ASSERT_EQUAL_UINT32(rotation.seed, restored.seed);
+}
+
+void test_other_corpus_not_restored()
+{
+	pick(100);
+	TEST_ASSERT_EQUAL_INT(RESTORE_NONE, restoreAphorismRotation(restored, CORPUS - 1));
+	loseRTC();
+	TEST_ASSERT_EQUAL_INT(RESTORE_NONE, restoreAphorismRotation(restored, CORPUS - 1));
+}
+
+void test_log_stays_bounded()
+{
+	pick(64 * APHORISM_CHECKPOINT_PICKS * 4);
+	TEST_ASSERT_TRUE(logSize() <= APHORISM_CHECKPOINT_RECORDS * RECORD);
+	TEST_ASSERT_EQUAL_INT(0, logSize() % RECORD);
+	TEST_ASSERT_FALSE(LittleFS.exists("/rotation.new"));
+}
+
+void test_log_start_over_survives_power_loss()
+{
+	// power lost while the full log was being started over: the old log is intact
+	while (logSize() < APHORISM_CHECKPOINT_RECORDS * RECORD)
+	{
+		pick(1);
+	}
+	File fresh = LittleFS.open("/rotation.new", "w");
+	fresh.write((const uint8_t *)"half a rec", 10);
+	fresh.close();
+	loseRTC();
+	TEST_ASSERT_EQUAL_INT(RESTORE_LOG, restoreAphorismRotation(restored, CORPUS)); // and starts it over
+	TEST_ASSERT_EQUAL_UINT32(rotation.seed, restored.seed);
+	TEST_ASSERT_EQUAL_INT(RECORD, logSize());
+	TEST_ASSERT_FALSE(LittleFS.exists("/rotation.new"));
+}
+
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_nothing_saved);
+	RUN_TEST(test_reset_restores_from_rtc);
+	RUN_TEST(test_power_loss_restores_from_log);
+	RUN_TEST(test_torn_record_skipped);
+	RUN_TEST(test_other_corpus_not_restored);
+	RUN_TEST(test_log_stays_bounded);
+	RUN_TEST(test_log_start_over_survives_power_loss);
+	return UNITY_END();
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_main.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Tests for the seeded aphorism permutation.
+ *
+ * Checks that permuteAphorismIndex() is a permutation for corpus sizes
+ * around the powers of four, and that nextAphorismIndex() gives every line
+ * once a cycle without the same line twice in a row across cycles.
+ * Runs natively (pio test -e native -f test_aphorism_rotation) or on the D1 mini.
+ */
+
+#include <string.h>
+#include <unity.h>
+#include "aphorismRotation.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+static char seen[4097]; // lines picked this cycle
+
+void setUp()
+{
+	memset(seen, 0, sizeof(seen));
+}
+
+void tearDown() {}
+
+void test_permutation_covers_every_line()
+{
+	static const uint16_t SIZES[] = {1, 2, 3, 4, 5, 15, 16, 17, 513, 514, 1024, 1025, 4097};
+	for (uint16_t size : SIZES)
+	{
+		for (uint32_t seed = 0; seed < 4; seed++)
+		{
+			memset(seen, 0, sizeof(seen));
+			for (uint16_t i = 0; i < size; i++)
+			{
+				uint16_t line = permuteAphorismIndex(seed * 0x9e3779b9UL, i, size);
+				TEST_ASSERT_TRUE(line < size);
+				TEST_ASSERT_FALSE(seen[line]);
+				seen[line] = 1;
+			}
+		}
+	}
+}
+
+void test_cycles_without_repeat()
+{
+	AphorismRotation rotation;
+	startAphorismRotation(rotation, 514, 12345);
+	int last = -1;
+	for (int cycle = 0; cycle < 5; cycle++)
+	{
+		memset(seen, 0, sizeof(seen));
+		for (int i = 0; i < 514; i++)
+		{
+			int line = nextAphorismIndex(rotation, 1000 + cycle);
+			TEST_ASSERT_TRUE(line >= 0 && line < 514);
+			TEST_ASSERT_FALSE(seen[line]);
+			TEST_ASSERT_NOT_EQUAL(last, line);
+			seen[line] = 1;
+			last = line;
+		}
+	}
+}
+
+void test_empty_rotation()
+{
+	AphorismRotation empty;
+	TEST_ASSERT_EQUAL_INT(-1, nextAphorismIndex(empty, 1));
+}
+
+#ifdef ARDUINO
+void setup()
+{
+	delay(2000); // let the serial monitor attach
+	UNITY_BEGIN();
+	RUN_TEST(test_permutation_covers_every_line);
+	RUN_TEST(test_cycles_without_repeat);
+	RUN_TEST(test_empty_rotation);
+	UNITY_END();
+}
+void loop() {}
+#else
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_permutation_covers_every_line);
+	RUN_TEST(test_cycles_without_repeat);
+	RUN_TEST(test_empty_rotation);
+	return UNITY_END();
+}
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file test_main.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Tests for the multi-part APRS texts.
+ *
+ * Checks that splitAPRSText() breaks every line of data/aphorisms.txt into
+ * whole-word parts that fit one message with their marker, cuts a word
+ * longer than a part and refuses what does not fit, and that the pending
+ * queue of sendAPRSText() fills, refuses and frees as aprsMultipartSlotFree()
+ * reports. The corpus test is skipped when the file system has no
+ * data/aphorisms.txt.
+ * Runs natively (pio test -e native -f test_aprs_multipart) or on the D1 mini.
+ */
+
+#include <string.h>
+#include <unity.h>
+#include <LittleFS.h>
+#include "aprsMultipart.h"
+#include "aprsParser.h"
+#include "credentials.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+// 41 characters, one message
+static const char *SHORT_TEXT = "A smooth sea never made a skilled sailor.";
+// 77 characters, two parts
+static const char *LONG_TEXT = "Measure twice, cut once; then measure again because the saw drifted a little.";
+
+void setUp()
+{
+	clearAPRSMultipart();
+	multipartStats = APRSMultipartStats();
+}
+
+void tearDown()
+{
+	clearAPRSMultipart();
+}
+
+void test_split_corpus()
+{
+	if (!LittleFS.begin() || !LittleFS.exists(APHORISM_FILE.c_str()))
+	{
+		TEST_IGNORE_MESSAGE("data/aphorisms.txt not found, run from the project directory");
+	}
+
+	// every line of the corpus must be sendable, in parts if need be
+	File file = LittleFS.open(APHORISM_FILE.c_str(), "r");
+	while (file.available())
+	{
+		String line = file.readStringUntil('\n');
+		line.trim();
+		if (line.length() == 0)
+		{
+			continue;
+		}
+		TEST_ASSERT_TRUE(line.length() <= (unsigned)APRS_MULTIPART_TEXT_MAX);
+
+		APRSTextPart parts[APRS_MULTIPART_PARTS_MAX];
+		int n = splitAPRSText(line.c_str(), line.length(), parts, APRS_MULTIPART_PARTS_MAX);
+		TEST_ASSERT_TRUE_MESSAGE(n > 0, line.c_str());
+		for (int k = 0; k < n; k++)
+		{
+			size_t marker = (n > 1) ? APRS_MULTIPART_MARKER : 0;
+			TEST_ASSERT_TRUE(parts[k].length + marker <= (size_t)APRS_MESSAGE_MAX);
+			TEST_ASSERT_NOT_EQUAL(' ', line[parts[k].offset]);
+			size_t end = parts[k].offset + parts[k].length;
+			TEST_ASSERT_TRUE(end == line.length() || line[end] == ' '); // whole words
+		}
+	}
+	file.close();
+}
+
+void test_split_edges()
+{
+	APRSTextPart parts[APRS_MULTIPART_PARTS_MAX];
+	const char *longWord = "Pneumonoultramicroscopicsilicovolcanoconiosis-pneumonoultramicroscopic dust";
+	TEST_ASSERT_EQUAL(2, splitAPRSText(longWord, strlen(longWord), parts, APRS_MULTIPART_PARTS_MAX));
+	TEST_ASSERT_EQUAL(APRS_MESSAGE_MAX - APRS_MULTIPART_MARKER, parts[0].length); // word cut
+
+	TEST_ASSERT_EQUAL(1, splitAPRSText(SHORT_TEXT, strlen(SHORT_TEXT), parts, 1));
+	TEST_ASSERT_EQUAL(0, parts[0].offset);
+	TEST_ASSERT_EQUAL(strlen(SHORT_TEXT), parts[0].length); // no marker
+	TEST_ASSERT_EQUAL(0, splitAPRSText(LONG_TEXT, strlen(LONG_TEXT), parts, 1));
+	TEST_ASSERT_EQUAL(0, splitAPRSText("   ", 3, parts, 1));
+}
+
+void test_pending_slots()
+{
+	TEST_ASSERT_TRUE(aprsMultipartSlotFree());
+	for (int i = 0; i < APRS_MULTIPART_QUEUE_SIZE; i++)
+	{
+		TEST_ASSERT_TRUE(sendAPRSText(MULTIPART_MESSAGE, "KD4AAA", LONG_TEXT, strlen(LONG_TEXT)));
+	}
+	TEST_ASSERT_FALSE(aprsMultipartSlotFree());
+
+	// a text in parts is refused, one that fits still goes
+	TEST_ASSERT_FALSE(sendAPRSText(MULTIPART_MESSAGE, "KD4AAA", LONG_TEXT, strlen(LONG_TEXT)));
+	TEST_ASSERT_TRUE(sendAPRSText(MULTIPART_MESSAGE, "KD4AAA", SHORT_TEXT, strlen(SHORT_TEXT)));
+	TEST_ASSERT_EQUAL_UINT32(1, multipartStats.refused);
+	TEST_ASSERT_EQUAL_UINT32(APRS_MULTIPART_QUEUE_SIZE + 1, multipartStats.texts);
+	TEST_ASSERT_EQUAL_UINT32(APRS_MULTIPART_QUEUE_SIZE, multipartStats.split);
+
+	// the connection is lost: the second parts are dropped and the slots freed
+	clearAPRSMultipart();
+	TEST_ASSERT_EQUAL_UINT32(APRS_MULTIPART_QUEUE_SIZE, multipartStats.dropped);
+	TEST_ASSERT_TRUE(aprsMultipartSlotFree());
+}
+
+#ifdef ARDUINO
+void setup()
+{
+	delay(2000); // let the serial monitor attach
+	UNITY_BEGIN();
+	RUN_TEST(test_split_corpus);
+	RUN_TEST(test_split_edges);
+	RUN_TEST(test_pending_slots);
+	UNITY_END();
+}
+void loop() {}
+#else
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_split_corpus);
+	RUN_TEST(test_split_edges);
+	RUN_TEST(test_pending_slots);
+	return UNITY_END();
+}
+#endif
@@ -0,0 +1,196 @@
+/**
+ * @file test_main.cpp
+ * @author Karl Berger
+ * @date 2026-10-16
+ * @brief Tests for the APRS-IS server failover list.
+ *
+ * Checks the backoff after consecutive failures (doubling, jitter bounds and
+ * cap), nextRetry() and the order select() tries the endpoints in.
+ * Runs natively (pio test -e native -f test_aprs_server_list) or on the D1 mini.
+ */
+
+#include <unity.h>
+#include "aprsServerList.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+static const APRSEndpoint SERVERS[] = {
+	{"first.example", 14580},
+	{"second.example", 14580},
+	{"third.example", 14580},
+};
+static const int SERVER_COUNT = sizeof(SERVERS) / sizeof(SERVERS[0]);
+
+static APRSServerList servers;
+
+//! Backoff before jitter after n consecutive failures
+static unsigned long fullBackoff(int n)
+{
+	unsigned long delay = APRS_BACKOFF_BASE_MS;
+	for (int i = 1; i < n && delay < APRS_BACKOFF_MAX_MS; i++)
+	{
+		delay *= 2;
+	}
+	return (delay < APRS_BACKOFF_MAX_MS) ? delay : APRS_BACKOFF_MAX_MS;
+}
+
+//! Connects and logs on to an endpoint with the given times.
+static void logOn(int index, unsigned long connectMs, unsigned long logrespMs)
+{
+	servers.recordAttempt(index);
+	servers.recordConnect(index, connectMs);
+	servers.recordLogon(index, logrespMs);
+}
+
+void setUp()
+{
+	servers.begin(SERVERS, SERVER_COUNT);
+}
+
+void tearDown() {}
+
+void test_backoff_doubles_with_jitter()
+{
+	const unsigned long now = 100000;
+	for (int n = 1; n <= 8; n++)
+	{
+		unsigned long full = fullBackoff(n);
+
+		// no jitter gives half the backoff, the largest jitter all of it
+		servers.begin(SERVERS, SERVER_COUNT);
+		for (int i = 0; i < n; i++)
+		{
+			servers.recordFailure(0, now, 0);
+		}
+		TEST_ASSERT_EQUAL_UINT32(full / 2, servers.health(0).retryAt - now);
+
+		servers.begin(SERVERS, SERVER_COUNT);
+		for (int i = 0; i < n; i++)
+		{
+			servers.recordFailure(0, now, (uint32_t)(full / 2));
+		}
+		TEST_ASSERT_EQUAL_UINT32(full / 2 + full / 2, servers.health(0).retryAt - now);
+		TEST_ASSERT_EQUAL_INT(n, servers.health(0).consecutive);
+	}
+
+	// any random number stays within half to all of the backoff
+	uint32_t random = 12345;
+	for (int n = 1; n <= 12; n++)
+	{
+		random = random * 1103515245UL + 12345;
+		servers.recordFailure(1, now, random);
+		unsigned long delay = servers.health(1).retryAt - now;
+		TEST_ASSERT_TRUE(delay >= fullBackoff(n) / 2);
+		TEST_ASSERT_TRUE(delay <= fullBackoff(n));
+	}
+	TEST_ASSERT_EQUAL_UINT32(12, servers.health(1).failures);
+}
+
+void test_backoff_is_capped()
+{
+	const unsigned long now = 5000;
+	for (int n = 1; n <= 40; n++)
+	{
+		servers.recordFailure(0, now, 0xFFFFFFFFUL);
+		unsigned long delay = servers.health(0).retryAt - now;
+		TEST_ASSERT_TRUE(delay <= APRS_BACKOFF_MAX_MS);
+	}
+	TEST_ASSERT_EQUAL_INT(31, servers.health(0).consecutive); // stops counting, keeps the cap
+	servers.recordFailure(0, now, 0);
+	TEST_ASSERT_EQUAL_UINT32(APRS_BACKOFF_MAX_MS / 2, servers.health(0).retryAt - now);
+	TEST_ASSERT_EQUAL_UINT32(41, servers.health(0).failures);
+}
+
+void test_next_retry()
+{
+	const unsigned long now = 0xFFFFF000UL; // backoffs run past the millis() wrap
+	TEST_ASSERT_EQUAL_UINT32(0, servers.nextRetry(now));
+
+	servers.recordFailure(0, now, 0); // 1000 ms
+	servers.recordFailure(1, now, 0);
+	servers.recordFailure(1, now, 0); // 2000 ms
+	TEST_ASSERT_EQUAL_UINT32(0, servers.nextRetry(now)); // the third is healthy
+	TEST_ASSERT_EQUAL_INT(2, servers.select(now));
+
+	servers.recordFailure(2, now, 0);
+	servers.recordFailure(2, now, 0);
+	servers.recordFailure(2, now, 0); // 4000 ms
+	TEST_ASSERT_EQUAL_UINT32(1000, servers.nextRetry(now));
+	TEST_ASSERT_EQUAL_INT(-1, servers.select(now));
+	TEST_ASSERT_EQUAL_UINT32(400, servers.nextRetry(now + 600));
+	TEST_ASSERT_EQUAL_UINT32(0, servers.nextRetry(now + 1000));
+	TEST_ASSERT_EQUAL_INT(0, servers.select(now + 1000));
+
+	// a verified logon ends the backoff at once
+	servers.recordLogon(2, 50);
+	TEST_ASSERT_EQUAL_INT(0, servers.health(2).consecutive);
+	TEST_ASSERT_EQUAL_UINT32(0, servers.nextRetry(now));
+	TEST_ASSERT_EQUAL_INT(2, servers.select(now));
+}
+
+void test_select_prefers_fastest_healthy()
+{
+	const unsigned long now = 60000;
+
+	// nothing measured: the order of the list
+	TEST_ASSERT_EQUAL_INT(0, servers.select(now));
+
+	// measured beats unmeasured, then the lowest connect plus logresp time
+	logOn(2, 120, 80);
+	TEST_ASSERT_EQUAL_INT(2, servers.select(now));
+	logOn(1, 40, 60);
+	TEST_ASSERT_EQUAL_INT(1, servers.select(now));
+	logOn(0, 90, 90);
+	TEST_ASSERT_EQUAL_INT(1, servers.select(now));
+
+	// the average of the rolling window counts, not the last sample
+	logOn(1, 300, 300);
+	TEST_ASSERT_EQUAL_UINT32(170, servers.avgConnectMs(1));
+	TEST_ASSERT_EQUAL_INT(0, servers.select(now));
+	for (int i = 0; i < APRS_LATENCY_SAMPLES; i++)
+	{
+		logOn(1, 20, 20); // pushes the slow sample out
+	}
+	TEST_ASSERT_EQUAL_UINT32(20, servers.avgConnectMs(1));
+	TEST_ASSERT_EQUAL_INT(1, servers.select(now));
+
+	// the fastest fails: skipped while backing off, and after it while it has
+	// more consecutive failures than the others
+	servers.recordFailure(1, now, 0);
+	TEST_ASSERT_EQUAL_INT(0, servers.select(now));
+	TEST_ASSERT_EQUAL_INT(0, servers.select(now + APRS_BACKOFF_BASE_MS));
+	logOn(1, 20, 20);
+	TEST_ASSERT_EQUAL_INT(1, servers.select(now + APRS_BACKOFF_BASE_MS));
+
+	// equal times: the earlier in the list
+	servers.begin(SERVERS, SERVER_COUNT);
+	logOn(2, 50, 50);
+	logOn(1, 50, 50);
+	TEST_ASSERT_EQUAL_INT(1, servers.select(now));
+}
+
+#ifdef ARDUINO
+void setup()
+{
+	delay(2000); // let the serial monitor attach
+	UNITY_BEGIN();
+	RUN_TEST(test_backoff_doubles_with_jitter);
+	RUN_TEST(test_backoff_is_capped);
+	RUN_TEST(test_next_retry);
+	RUN_TEST(test_select_prefers_fastest_healthy);
+	UNITY_END();
+}
+void loop() {}
+#else
+int main()
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_backoff_doubles_with_jitter);
+	RUN_TEST(test_backoff_is_capped);
+	RUN_TEST(test_next_retry);
+	RUN_TEST(test_select_prefers_fastest_healthy);
+	return UNITY_END();
+}
+#endif